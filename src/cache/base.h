@@ -80,6 +80,13 @@ class BasicCache {
 		virtual void setVerbose() {
 		}
 
+		/**
+		Set prefetch mode: Announce the files of a category to the kernel
+		in readCategoryPrepare() so that they are read ahead in the background
+		**/
+		virtual void setPrefetch() {
+		}
+
 		/**
 		Get overlay-key
 		**/
@@ -33,6 +33,18 @@
 
 using std::string;
 
+/**
+Copy *src to *dest or move it if src is no longer needed
+**/
+template<typename T> ATTRIBUTE_NONNULL_ inline static void copy_or_move(T *dest, T *src, bool move);
+template<typename T> inline static void copy_or_move(T *dest, T *src, bool move) {
+	if(move) {
+		*dest = MOVE(*src);
+	} else {
+		*dest = *src;
+	}
+}
+
 EixCache::CachesList *EixCache::all_eixcaches = NULLPTR;
 
 EixCache::~EixCache() {
@@ -164,7 +176,12 @@ bool EixCache::get_destcat(PackageTree *packagetree, const char *cat_name, Categ
 	return false;
 }
 
-void EixCache::get_package(Package *p) {
+/**
+Add the matching versions of p to dest_cat.
+@param steal if true, p is not used by other slaves, so we may move the
+data of its versions
+**/
+void EixCache::get_package(Package *p, bool steal) {
 	if(dest_cat == NULLPTR) {
 		return;
 	}
@@ -179,15 +196,15 @@ void EixCache::get_package(Package *p) {
 		*static_cast<BasicVersion *>(version) = *static_cast<BasicVersion *>(*it);
 		version->overlay_key = m_overlay_key;
 		version->set_full_keywords(it->get_full_keywords());
-		version->slotname = it->slotname;
-		version->subslotname = it->subslotname;
+		copy_or_move(&(version->slotname), &(it->slotname), steal);
+		copy_or_move(&(version->subslotname), &(it->subslotname), steal);
 		version->restrictFlags = it->restrictFlags;
 		version->propertiesFlags = it->propertiesFlags;
-		version->iuse = it->iuse;
-		version->required_use = it->required_use;
+		copy_or_move(&(version->iuse), &(it->iuse), steal);
+		copy_or_move(&(version->required_use), &(it->required_use), steal);
 		version->eapi = it->eapi;
-		version->depend = it->depend;
-		version->src_uri = it->src_uri;
+		copy_or_move(&(version->depend), &(it->depend), steal);
+		copy_or_move(&(version->src_uri), &(it->src_uri), steal);
 		if(pkg == NULLPTR) {
 			pkg = dest_cat->findPackage(p->name);
 			if(pkg != NULLPTR) {
@@ -263,6 +280,10 @@ bool EixCache::readCategories(PackageTree *packagetree, const char *cat_name, Ca
 	}
 
 	PackageReader reader(&db, header);
+	// The versions are only copied, and the masks are recalculated anyway
+	reader.skip_masks();
+	// With only one reader of the data, we can move instead of copy
+	const bool steal(slaves.size() == 1);
 	for(; reader.next(); reader.skip()) {
 		if(unlikely(!reader.read(PackageReader::NAME))) {
 			break;
@@ -285,7 +306,7 @@ bool EixCache::readCategories(PackageTree *packagetree, const char *cat_name, Ca
 		p = reader.get();
 		for(CachesList::const_iterator sl(slaves.begin());
 			unlikely(sl != slaves.end()); ++sl) {
-			sl->get_package(p);
+			sl->get_package(p, steal);
 		}
 	}
 	const char *err_cstr(reader.get_errtext());
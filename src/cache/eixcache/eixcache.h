@@ -42,7 +42,7 @@ class EixCache FINAL : public BasicCache {
 		void thiserror(const std::string& msg);
 		bool get_overlaydat(const DBHeader& header);
 		bool get_destcat(PackageTree *packagetree, const char *cat_name, Category *category, const std::string& pcat);
-		ATTRIBUTE_NONNULL_ void get_package(Package *p);
+		ATTRIBUTE_NONNULL_ void get_package(Package *p, bool steal);
 
 	public:
 		~EixCache();
@@ -236,14 +236,14 @@ bool MetadataCache::readCategoryPrepare(const char *cat_name) {
 
 	bool r(scandir_cc(m_catpath, &names, cachefiles_selector));
 	if(path_type != PATH_METADATAMD5OR) {
-		return r;
+		return prefetchCategory(r);
 	}
 	// PATH_METADATAMD5OR:
 	if(r) {  // We had found category in METADATAMD5_PATH
 		if(flat) {  // We "jump" to non-flat PATH_METADATAMD5 mode:
 			setFlat(false);
 		}
-		return true;
+		return prefetchCategory(true);
 	}
 	// We choose metadata-flat or metadata-assign:
 	m_catpath = alt;
@@ -252,7 +252,25 @@ bool MetadataCache::readCategoryPrepare(const char *cat_name) {
 	if(flat) {  // We "jump" to flat PATH_METADATA mode:
 		setFlat(true);
 	}
-	return scandir_cc(m_catpath, &names, cachefiles_selector);
+	return prefetchCategory(scandir_cc(m_catpath, &names, cachefiles_selector));
+}
+
+bool MetadataCache::prefetchCategory(bool r) const {
+	if(!(r && prefetch)) {
+		return r;
+	}
+	// The reads are started asynchronously by the kernel, so the disk
+	// can work on all files of the category while we parse the first ones
+	string path(m_catpath);
+	path.append(1, '/');
+	const string::size_type len(path.size());
+	for(WordVec::const_iterator it(names.begin());
+		likely(it != names.end()); ++it) {
+		path.erase(len);
+		path.append(*it);
+		prefetch_file(path.c_str());
+	}
+	return true;
 }
 
 void MetadataCache::readCategoryFinalize() {
@@ -39,7 +39,7 @@ class MetadataCache FINAL : public BasicCache {
 			PATH_REPOSITORY
 		} PathType;
 		PathType path_type;
-		bool flat, have_override_path;
+		bool flat, have_override_path, prefetch;
 		std::string override_path;
 		std::string m_type;
 		std::string m_catpath;
@@ -50,8 +50,14 @@ class MetadataCache FINAL : public BasicCache {
 		void setType(PathType set_path_type, bool set_flat);
 		void setFlat(bool set_flat);
 
+		/**
+		@return r; if r is true and prefetch mode is set,
+		the files of the category are announced to the kernel
+		**/
+		bool prefetchCategory(bool r) const;
+
 	public:
-		MetadataCache() : reader(NULLPTR) {
+		MetadataCache() : prefetch(false), reader(NULLPTR) {
 		}
 
 		~MetadataCache() {
@@ -60,6 +66,10 @@ class MetadataCache FINAL : public BasicCache {
 
 		bool initialize(const std::string& name);
 
+		void setPrefetch() OVERRIDE {
+			prefetch = true;
+		}
+
 		ATTRIBUTE_NONNULL_ bool readCategoryPrepare(const char *cat_name) OVERRIDE;
 		ATTRIBUTE_NONNULL_ bool readCategory(Category *cat) OVERRIDE;
 		void readCategoryFinalize() OVERRIDE;
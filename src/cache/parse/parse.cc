@@ -165,6 +165,13 @@ void ParseCache::setErrorCallback(ErrorCallback error_callback) {
 	}
 }
 
+void ParseCache::setPrefetch() {
+	for(FurtherCaches::iterator it(further.begin());
+		likely(it != further.end()); ++it) {
+		(*it)->setPrefetch();
+	}
+}
+
 void ParseCache::set_checking(string *str, const char *item, const VarsReader& ebuild, bool *ok) {
 	bool check((ebuild_exec != NULLPTR) && (ok != NULLPTR) && (*ok));
 	const string *s(ebuild.find(item));
@@ -387,7 +394,8 @@ bool ParseCache::readCategoryPrepare(const char *cat_name) {
 		further_works.PUSH_BACK((*it)->readCategoryPrepare(cat_name));
 	}
 	m_catpath = m_prefix + m_scheme + '/' + cat_name;
-	return scandir_cc(m_catpath, &m_packages, package_selector);
+	// Only directories: Avoids trying to open e.g. metadata.xml later on
+	return scandir_cc(m_catpath, &m_packages, package_selector, 2, true);
 }
 
 void ParseCache::readCategoryFinalize() {
@@ -64,6 +64,8 @@ class ParseCache FINAL : public BasicCache {
 			verbose = true;
 		}
 
+		void setPrefetch() OVERRIDE;
+
 		ATTRIBUTE_NONNULL_ bool readCategoryPrepare(const char *cat_name) OVERRIDE;
 		ATTRIBUTE_NONNULL_ bool readCategory(Category *cat) OVERRIDE;
 		void readCategoryFinalize() OVERRIDE;
@@ -12,9 +12,12 @@
 
 #include <config.h>  // IWYU pragma: keep
 
+#include <map>
 #include <set>
 #include <string>
+#include <vector>
 
+#include "database/name_index.h"
 #include "eixTk/attribute.h"
 #include "eixTk/dialect.h"
 #include "eixTk/eixint.h"
@@ -51,12 +54,60 @@ class DBHeader {
 			SAVE_BITMASK_NONE         = 0x00U,
 			SAVE_BITMASK_DEP          = 0x01U,
 			SAVE_BITMASK_REQUIRED_USE = 0x02U,
-			SAVE_BITMASK_SRC_URI      = 0x04U;
+			SAVE_BITMASK_SRC_URI      = 0x04U,
+			SAVE_BITMASK_ACCEPT_KEYWORDS = 0x08U;
 
 		bool use_depend, use_required_use, use_src_uri;
 
+		/**
+		Whether the stability summaries of the packages were calculated
+		with ALWAYS_ACCEPT_KEYWORDS=true
+		**/
+		bool always_accept_keywords;
+
 		WordVec world_sets;
 
+		/**
+		For each entry of iuse_hash the (increasing) ordinal numbers of
+		the packages with some version having this IUSE.
+		This is only filled for writing: When reading, the index is
+		skipped and can be read on demand with PackageReader::iuse_index()
+		**/
+		typedef std::vector<std::vector<eix::Treesize> > IUseIndex;
+		IUseIndex iuse_index;
+
+		/**
+		Position of the IUSE index in the database or 0 if there is none
+		**/
+		eix::OffsetType iuse_index_offset;
+
+		/**
+		For each category/name occurring in some dependency the
+		(increasing) ordinal numbers of the packages depending on it.
+		As iuse_index, this is only filled for writing, see
+		PackageReader::revdep_index()
+		**/
+		typedef std::map<std::string, std::vector<eix::Treesize> > RevdepIndex;
+		RevdepIndex revdep_index;
+
+		/**
+		Position of the reverse dependency index in the database
+		or 0 if there is none
+		**/
+		eix::OffsetType revdep_index_offset;
+
+		/**
+		The sorted package names with a BK-tree for fuzzy search.
+		As iuse_index, this is only filled for writing, see
+		PackageReader::name_index()
+		**/
+		NameIndex name_index;
+
+		/**
+		Position of the name index in the database or 0 if there is none
+		**/
+		eix::OffsetType name_index_offset;
+
 		typedef  eix::UNumber DBVersion;
 
 		typedef  eix::UChar OverlayTest;
@@ -75,7 +126,7 @@ class DBHeader {
 		/**
 		Current version of database-format and what we accept
 		**/
-		static CONSTEXPR const DBVersion current = 38;
+		static CONSTEXPR const DBVersion current = 39;
 		static const DBHeader::DBVersion accept[];
 
 		/**
@@ -87,6 +138,9 @@ class DBHeader {
 		**/
 		eix::Catsize size;
 
+		DBHeader() : always_accept_keywords(false), iuse_index_offset(0), revdep_index_offset(0), name_index_offset(0) {
+		}
+
 		/**
 		Get overlay for key from table
 		**/
@@ -13,8 +13,10 @@
 #include <cstdio>
 
 #include <string>
+#include <vector>
 
 #include "database/header.h"
+#include "database/name_index.h"
 #include "eixTk/attribute.h"
 #include "eixTk/diagnostics.h"
 #include "eixTk/dialect.h"
@@ -174,6 +176,36 @@ class Database : public File {
 		bool write_hash(const StringHash& hash, std::string *errtext);
 		ATTRIBUTE_NONNULL((2)) bool read_hash(StringHash *hash, std::string *errtext);
 
+		bool write_iuse_index(const DBHeader::IUseIndex& index, std::string *errtext);
+
+		/**
+		Read the IUSE index at hdr.iuse_index_offset (if there is one)
+		and return to the current position
+		**/
+		ATTRIBUTE_NONNULL((3)) bool read_iuse_index(const DBHeader& hdr, DBHeader::IUseIndex *index, std::string *errtext);
+
+		bool write_revdep_index(const DBHeader::RevdepIndex& index, std::string *errtext);
+
+		/**
+		Read the reverse dependency index at hdr.revdep_index_offset
+		(if there is one) and return to the current position
+		**/
+		ATTRIBUTE_NONNULL((3)) bool read_revdep_index(const DBHeader& hdr, DBHeader::RevdepIndex *index, std::string *errtext);
+
+		bool write_name_index(const NameIndex& index, std::string *errtext);
+
+		/**
+		Read the name index at hdr.name_index_offset (if there is one)
+		and return to the current position
+		**/
+		ATTRIBUTE_NONNULL((3)) bool read_name_index(const DBHeader& hdr, NameIndex *index, std::string *errtext);
+
+		/**
+		Increasing ordinal numbers of packages are stored as differences
+		**/
+		bool write_ordinals(const std::vector<eix::Treesize>& ordinals, std::string *errtext);
+		ATTRIBUTE_NONNULL((2)) bool read_ordinals(std::vector<eix::Treesize> *ordinals, std::string *errtext);
+
 	public:
 		Database() : counting(false), counter(0) {
 		}
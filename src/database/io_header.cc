@@ -121,6 +121,7 @@ GCC_DIAG_ON(sign-conversion)
 	}
 	hdr->use_required_use = ((save_bitmask & DBHeader::SAVE_BITMASK_REQUIRED_USE) != DBHeader::SAVE_BITMASK_NONE);
 	hdr->use_src_uri = ((save_bitmask & DBHeader::SAVE_BITMASK_SRC_URI) != DBHeader::SAVE_BITMASK_NONE);
+	hdr->always_accept_keywords = ((save_bitmask & DBHeader::SAVE_BITMASK_ACCEPT_KEYWORDS) != DBHeader::SAVE_BITMASK_NONE);
 	if((hdr->use_depend = ((save_bitmask & DBHeader::SAVE_BITMASK_DEP) != DBHeader::SAVE_BITMASK_NONE))) {
 		eix::OffsetType len;
 		if(unlikely(!read_num(&len, errtext))) {
@@ -136,6 +137,36 @@ GCC_DIAG_ON(sign-conversion)
 			}
 		}
 	}
+	hdr->iuse_index_offset = 0;
+	hdr->revdep_index_offset = 0;
+	hdr->name_index_offset = 0;
+	if(unlikely(hdr->version < 39)) {
+		return true;
+	}
+	eix::OffsetType len;
+	if(unlikely(!read_num(&len, errtext))) {
+		return false;
+	}
+	hdr->iuse_index_offset = tell();
+	if(unlikely(!seekrel(len, errtext))) {
+		return false;
+	}
+	if(hdr->use_depend) {
+		if(unlikely(!read_num(&len, errtext))) {
+			return false;
+		}
+		hdr->revdep_index_offset = tell();
+		if(unlikely(!seekrel(len, errtext))) {
+			return false;
+		}
+	}
+	if(unlikely(!read_num(&len, errtext))) {
+		return false;
+	}
+	hdr->name_index_offset = tell();
+	if(unlikely(!seekrel(len, errtext))) {
+		return false;
+	}
 	return true;
 }
 
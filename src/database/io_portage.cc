@@ -8,14 +8,18 @@
 #include "database/io.h"
 #include <config.h>  // IWYU pragma: keep
 
+#include <map>
 #include <string>
+#include <vector>
 
 #include "database/header.h"
+#include "database/name_index.h"
 #include "database/package_reader.h"
 #include "eixTk/auto_array.h"
 #include "eixTk/diagnostics.h"
 #include "eixTk/dialect.h"
 #include "eixTk/eixint.h"
+#include "eixTk/i18n.h"
 #include "eixTk/likely.h"
 #include "eixTk/null.h"
 #include "eixTk/stringtypes.h"
@@ -29,7 +33,9 @@
 #include "portage/packagetree.h"
 #include "portage/version.h"
 
+using std::map;
 using std::string;
+using std::vector;
 
 #define WRITE_COUNTER(f) do { \
 	eix::OffsetType counter_save(counter); \
@@ -295,6 +301,9 @@ bool Database::write_category_header(const string& name, eix::Treesize size, str
 }
 
 bool Database::write_package_pure(const Package& pkg, const DBHeader& hdr, string *errtext) {
+	if(unlikely(!write_num(pkg.dbflags(), errtext))) {
+		return false;
+	}
 	if(unlikely(!write_string(pkg.name, errtext))) {
 		return false;
 	}
@@ -383,6 +392,273 @@ void Database::prep_header_hashs(DBHeader *hdr, const PackageTree& tree) {
 	if(use_dep) {
 		hdr->depend_hash.finalize();
 	}
+
+	// The packages are numbered in the order of write_packagetree()
+	hdr->iuse_index.assign(hdr->iuse_hash.size(), vector<eix::Treesize>());
+	hdr->revdep_index.clear();
+	map<string, NameIndex::Packages> names;
+	WordVec categories;
+	NameIndex::Packages category_begin;
+	eix::Treesize ordinal(0);
+	for(PackageTree::const_iterator c(tree.begin()); likely(c != tree.end()); ++c) {
+		categories.PUSH_BACK(c->first);
+		category_begin.PUSH_BACK(ordinal);
+		Category *ci(c->second);
+		for(Category::iterator p(ci->begin()); likely(p != ci->end()); ++p, ++ordinal) {
+			names[p->name].PUSH_BACK(ordinal);
+			WordSet dependencies;
+			for(Package::iterator v(p->begin()); likely(v != p->end()); ++v) {
+				WordVec iuse(v->iuse.asVector());
+				for(WordVec::const_iterator it(iuse.begin()); likely(it != iuse.end()); ++it) {
+					vector<eix::Treesize>& packages(hdr->iuse_index[hdr->iuse_hash.get_index(*it)]);
+					if(packages.empty() || (packages.back() != ordinal)) {
+						packages.PUSH_BACK(ordinal);
+					}
+				}
+				if(use_dep) {
+					v->depend.add_packages(&dependencies);
+				}
+			}
+			for(WordSet::const_iterator it(dependencies.begin());
+				likely(it != dependencies.end()); ++it) {
+				hdr->revdep_index[*it].PUSH_BACK(ordinal);
+			}
+		}
+	}
+	category_begin.PUSH_BACK(ordinal);
+	hdr->name_index.init(names, categories, category_begin);
+}
+
+/**
+For each entry of the hash the number of packages, followed by the
+differences of their ordinal numbers (the first relative to 0)
+**/
+bool Database::write_iuse_index(const DBHeader::IUseIndex& index, string *errtext) {
+	for(DBHeader::IUseIndex::const_iterator it(index.begin());
+		likely(it != index.end()); ++it) {
+		if(unlikely(!write_ordinals(*it, errtext))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Database::write_ordinals(const vector<eix::Treesize>& ordinals, string *errtext) {
+	if(unlikely(!write_num(ordinals.size(), errtext))) {
+		return false;
+	}
+	eix::Treesize prev(0);
+	for(vector<eix::Treesize>::const_iterator it(ordinals.begin());
+		likely(it != ordinals.end()); ++it) {
+		if(unlikely(!write_num(*it - prev, errtext))) {
+			return false;
+		}
+		prev = *it;
+	}
+	return true;
+}
+
+bool Database::read_ordinals(vector<eix::Treesize> *ordinals, string *errtext) {
+	vector<eix::Treesize>::size_type count;
+	if(unlikely(!read_num(&count, errtext))) {
+		return false;
+	}
+	ordinals->reserve(count);
+	eix::Treesize ordinal(0);
+	for(; likely(count != 0); --count) {
+		eix::Treesize diff;
+		if(unlikely(!read_num(&diff, errtext))) {
+			return false;
+		}
+		ordinal += diff;
+		ordinals->PUSH_BACK(ordinal);
+	}
+	return true;
+}
+
+/**
+A vector of pairs: category/name and the packages depending on it
+**/
+bool Database::write_revdep_index(const DBHeader::RevdepIndex& index, string *errtext) {
+	if(unlikely(!write_num(index.size(), errtext))) {
+		return false;
+	}
+	for(DBHeader::RevdepIndex::const_iterator it(index.begin());
+		likely(it != index.end()); ++it) {
+		if(unlikely(!write_string(it->first, errtext))) {
+			return false;
+		}
+		if(unlikely(!write_ordinals(it->second, errtext))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Database::read_revdep_index(const DBHeader& hdr, DBHeader::RevdepIndex *index, string *errtext) {
+	index->clear();
+	if(hdr.revdep_index_offset == 0) {
+		return true;
+	}
+	eix::OffsetType current(tell());
+	if(unlikely(!seekabs(hdr.revdep_index_offset, errtext))) {
+		return false;
+	}
+	DBHeader::RevdepIndex::size_type count;
+	if(unlikely(!read_num(&count, errtext))) {
+		return false;
+	}
+	for(; likely(count != 0); --count) {
+		string name;
+		if(unlikely(!read_string(&name, errtext))) {
+			return false;
+		}
+		if(unlikely(!read_ordinals(&((*index)[name]), errtext))) {
+			return false;
+		}
+	}
+	return seekabs(current, errtext);
+}
+
+/**
+For each name: the name, the packages, and the children in the BK-tree;
+then the order of the reversed names; then the categories, each with the
+ordinal of its first package, and the number of packages
+**/
+bool Database::write_name_index(const NameIndex& index, string *errtext) {
+	if(unlikely(!write_num(index.entries.size(), errtext))) {
+		return false;
+	}
+	for(NameIndex::Entries::const_iterator it(index.entries.begin());
+		likely(it != index.entries.end()); ++it) {
+		if(unlikely(!write_string(it->name, errtext))) {
+			return false;
+		}
+		if(unlikely(!write_ordinals(it->packages, errtext))) {
+			return false;
+		}
+		if(unlikely(!write_num(it->children.size(), errtext))) {
+			return false;
+		}
+		for(NameIndex::Children::const_iterator child(it->children.begin());
+			likely(child != it->children.end()); ++child) {
+			if(unlikely(!write_num(child->first, errtext))) {
+				return false;
+			}
+			if(unlikely(!write_num(child->second, errtext))) {
+				return false;
+			}
+		}
+	}
+	for(vector<NameIndex::Index>::const_iterator it(index.reversed.begin());
+		likely(it != index.reversed.end()); ++it) {
+		if(unlikely(!write_num(*it, errtext))) {
+			return false;
+		}
+	}
+	if(unlikely(!write_num(index.categories.size(), errtext))) {
+		return false;
+	}
+	for(WordVec::size_type i(0); likely(i < index.categories.size()); ++i) {
+		if(unlikely(!write_string(index.categories[i], errtext))) {
+			return false;
+		}
+		if(unlikely(!write_num(index.category_begin[i], errtext))) {
+			return false;
+		}
+	}
+	return write_num(index.category_begin.back(), errtext);
+}
+
+bool Database::read_name_index(const DBHeader& hdr, NameIndex *index, string *errtext) {
+	index->clear();
+	if(hdr.name_index_offset == 0) {
+		return true;
+	}
+	eix::OffsetType current(tell());
+	if(unlikely(!seekabs(hdr.name_index_offset, errtext))) {
+		return false;
+	}
+	NameIndex::Entries::size_type count;
+	if(unlikely(!read_num(&count, errtext))) {
+		return false;
+	}
+	index->entries.resize(count);
+	for(NameIndex::Entries::iterator it(index->entries.begin());
+		likely(it != index->entries.end()); ++it) {
+		if(unlikely(!read_string(&(it->name), errtext))) {
+			return false;
+		}
+		if(unlikely(!read_ordinals(&(it->packages), errtext))) {
+			return false;
+		}
+		NameIndex::Children::size_type children;
+		if(unlikely(!read_num(&children, errtext))) {
+			return false;
+		}
+		it->children.resize(children);
+		for(NameIndex::Children::iterator child(it->children.begin());
+			likely(child != it->children.end()); ++child) {
+			if(unlikely(!read_num(&(child->first), errtext))) {
+				return false;
+			}
+			if(unlikely(!read_num(&(child->second), errtext))) {
+				return false;
+			}
+			if(unlikely(child->second >= count)) {
+				*errtext = _("corrupt name index");
+				return false;
+			}
+		}
+	}
+	index->reversed.resize(count);
+	for(vector<NameIndex::Index>::iterator it(index->reversed.begin());
+		likely(it != index->reversed.end()); ++it) {
+		if(unlikely(!read_num(&(*it), errtext))) {
+			return false;
+		}
+		if(unlikely(*it >= count)) {
+			*errtext = _("corrupt name index");
+			return false;
+		}
+	}
+	WordVec::size_type categories;
+	if(unlikely(!read_num(&categories, errtext))) {
+		return false;
+	}
+	index->categories.resize(categories);
+	index->category_begin.resize(categories + 1);
+	for(WordVec::size_type i(0); likely(i < categories); ++i) {
+		if(unlikely(!read_string(&(index->categories[i]), errtext))) {
+			return false;
+		}
+		if(unlikely(!read_num(&(index->category_begin[i]), errtext))) {
+			return false;
+		}
+	}
+	if(unlikely(!read_num(&(index->category_begin[categories]), errtext))) {
+		return false;
+	}
+	return seekabs(current, errtext);
+}
+
+bool Database::read_iuse_index(const DBHeader& hdr, DBHeader::IUseIndex *index, string *errtext) {
+	index->clear();
+	if(hdr.iuse_index_offset == 0) {
+		return true;
+	}
+	eix::OffsetType current(tell());
+	if(unlikely(!seekabs(hdr.iuse_index_offset, errtext))) {
+		return false;
+	}
+	index->resize(hdr.iuse_hash.size());
+	for(DBHeader::IUseIndex::iterator it(index->begin());
+		likely(it != index->end()); ++it) {
+		if(unlikely(!read_ordinals(&(*it), errtext))) {
+			return false;
+		}
+	}
+	return seekabs(current, errtext);
 }
 
 bool Database::write_header(const DBHeader& hdr, string *errtext) {
@@ -444,14 +720,30 @@ bool Database::write_header(const DBHeader& hdr, string *errtext) {
 	if(hdr.use_required_use) {
 		save_bitmask |= DBHeader::SAVE_BITMASK_REQUIRED_USE;
 	}
+	if(hdr.always_accept_keywords) {
+		save_bitmask |= DBHeader::SAVE_BITMASK_ACCEPT_KEYWORDS;
+	}
 	if(unlikely(!write_num(save_bitmask, errtext))) {
 		return false;
 	}
-	if(!hdr.use_depend) {
-		return true;
+	if(hdr.use_depend) {
+		WRITE_COUNTER(write_hash(hdr.depend_hash, NULLPTR));
+		if(unlikely(!write_hash(hdr.depend_hash, errtext))) {
+			return false;
+		}
+	}
+	WRITE_COUNTER(write_iuse_index(hdr.iuse_index, NULLPTR));
+	if(unlikely(!write_iuse_index(hdr.iuse_index, errtext))) {
+		return false;
+	}
+	if(hdr.use_depend) {
+		WRITE_COUNTER(write_revdep_index(hdr.revdep_index, NULLPTR));
+		if(unlikely(!write_revdep_index(hdr.revdep_index, errtext))) {
+			return false;
+		}
 	}
-	WRITE_COUNTER(write_hash(hdr.depend_hash, NULLPTR));
-	return write_hash(hdr.depend_hash, errtext);
+	WRITE_COUNTER(write_name_index(hdr.name_index, NULLPTR));
+	return write_name_index(hdr.name_index, errtext);
 }
 
 bool Database::write_packagetree(const PackageTree& tree, const DBHeader& hdr, string *errtext) {
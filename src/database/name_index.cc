@@ -0,0 +1,175 @@
+// vim:set noet cinoptions= sw=4 ts=4:
+// This file is part of the eix project and distributed under the
+// terms of the GNU General Public License v2.
+//
+// Copyright (c)
+//   Martin Väth <martin@mvath.de>
+
+#include "database/name_index.h"
+#include <config.h>  // IWYU pragma: keep
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "eixTk/attribute.h"
+#include "eixTk/dialect.h"
+#include "eixTk/likely.h"
+#include "search/levenshtein.h"
+
+using std::lexicographical_compare;
+using std::lower_bound;
+using std::map;
+using std::sort;
+using std::string;
+using std::vector;
+
+/**
+Compare entries by name with a string
+**/
+class NameLess {
+	public:
+		bool operator()(const NameIndex::Entry& entry, const string& s) const {
+			return (entry.name < s);
+		}
+};
+
+/**
+Compare the reversed names of entries (given by indices)
+with each other or with a reversed string
+**/
+class ReversedLess {
+	protected:
+		const NameIndex::Entries& entries;
+
+	public:
+		explicit ReversedLess(const NameIndex::Entries& e) : entries(e) {
+		}
+
+		ATTRIBUTE_PURE bool operator()(NameIndex::Index a, NameIndex::Index b) const {
+			const string& s(entries[a].name);
+			const string& t(entries[b].name);
+			return lexicographical_compare(s.rbegin(), s.rend(), t.rbegin(), t.rend());
+		}
+
+		ATTRIBUTE_PURE bool operator()(NameIndex::Index a, const string& reversed) const {
+			const string& s(entries[a].name);
+			return lexicographical_compare(s.rbegin(), s.rend(), reversed.begin(), reversed.end());
+		}
+};
+
+ATTRIBUTE_PURE static bool has_suffix(const string& s, const string& suffix);
+static bool has_suffix(const string& s, const string& suffix) {
+	return ((s.size() >= suffix.size()) &&
+		(s.compare(s.size() - suffix.size(), string::npos, suffix) == 0));
+}
+
+void NameIndex::init(const map<string, Packages>& names, const vector<string>& cats, const Packages& cat_begin) {
+	categories = cats;
+	category_begin = cat_begin;
+	entries.clear();
+	entries.resize(names.size());
+	Index i(0);
+	for(map<string, Packages>::const_iterator it(names.begin());
+		likely(it != names.end()); ++it, ++i) {
+		Entry& entry(entries[i]);
+		entry.name = it->first;
+		entry.packages = it->second;
+		if(unlikely(i == 0)) {
+			continue;
+		}
+		// Insert into the BK-tree. Distinct names have positive distance
+		Index node(0);
+		for(;;) {
+			Levenshtein d(get_levenshtein_distance(entries[node].name.c_str(),
+				entry.name.c_str()));
+			Children& children(entries[node].children);
+			Children::const_iterator child(children.begin());
+			for(; likely(child != children.end()); ++child) {
+				if(child->first == d) {
+					break;
+				}
+			}
+			if(child == children.end()) {
+				children.PUSH_BACK(Child(d, i));
+				break;
+			}
+			node = child->second;
+		}
+	}
+	reversed.resize(entries.size());
+	for(Index j(0); likely(j < reversed.size()); ++j) {
+		reversed[j] = j;
+	}
+	sort(reversed.begin(), reversed.end(), ReversedLess(entries));
+}
+
+void NameIndex::find_exact(vector<Index> *result, const string& s) const {
+	Entries::const_iterator it(lower_bound(entries.begin(), entries.end(), s, NameLess()));
+	if((it != entries.end()) && (it->name == s)) {
+		result->PUSH_BACK(static_cast<Index>(it - entries.begin()));
+	}
+}
+
+void NameIndex::find_prefix(vector<Index> *result, const string& prefix) const {
+	for(Entries::const_iterator it(lower_bound(entries.begin(), entries.end(), prefix, NameLess()));
+		(it != entries.end()) && (it->name.compare(0, prefix.size(), prefix) == 0); ++it) {
+		result->PUSH_BACK(static_cast<Index>(it - entries.begin()));
+	}
+}
+
+void NameIndex::find_suffix(vector<Index> *result, const string& suffix) const {
+	string reversed_suffix(suffix.rbegin(), suffix.rend());
+	for(vector<Index>::const_iterator it(lower_bound(reversed.begin(), reversed.end(), reversed_suffix, ReversedLess(entries)));
+		(it != reversed.end()) && has_suffix(entries[*it].name, suffix); ++it) {
+		result->PUSH_BACK(*it);
+	}
+}
+
+void NameIndex::find_category_prefix(vector<Index> *result, const string& prefix) const {
+	for(vector<string>::const_iterator it(lower_bound(categories.begin(), categories.end(), prefix));
+		(it != categories.end()) && (it->compare(0, prefix.size(), prefix) == 0); ++it) {
+		result->PUSH_BACK(static_cast<Index>(it - categories.begin()));
+	}
+}
+
+bool NameIndex::find_category(Index *result, const string& category) const {
+	vector<string>::const_iterator it(lower_bound(categories.begin(), categories.end(), category));
+	if((it == categories.end()) || (*it != category)) {
+		return false;
+	}
+	*result = static_cast<Index>(it - categories.begin());
+	return true;
+}
+
+bool NameIndex::in_category(const Entry& entry, Index cat) const {
+	// The packages of entry are sorted
+	Packages::const_iterator it(lower_bound(entry.packages.begin(), entry.packages.end(), category_begin[cat]));
+	return ((it != entry.packages.end()) && (*it < category_begin[cat + 1]));
+}
+
+void NameIndex::find_fuzzy(vector<Index> *result, const char *s, Levenshtein max) const {
+	if(unlikely(entries.empty())) {
+		return;
+	}
+	vector<Index> todo;
+	todo.PUSH_BACK(0);
+	while(likely(!todo.empty())) {
+		Index index(todo.back());
+		todo.pop_back();
+		const Entry& entry(entries[index]);
+		Levenshtein d(get_levenshtein_distance(s, entry.name.c_str()));
+		if(d <= max) {
+			result->PUSH_BACK(index);
+		}
+		// By the triangle inequality only subtrees with distance
+		// in [d - max, d + max] can contain matches
+		for(Children::const_iterator child(entry.children.begin());
+			likely(child != entry.children.end()); ++child) {
+			if((child->first + max >= d) && (child->first <= d + max)) {
+				todo.PUSH_BACK(child->second);
+			}
+		}
+	}
+}
@@ -0,0 +1,118 @@
+// vim:set noet cinoptions= sw=4 ts=4:
+// This file is part of the eix project and distributed under the
+// terms of the GNU General Public License v2.
+//
+// Copyright (c)
+//   Martin Väth <martin@mvath.de>
+
+#ifndef SRC_DATABASE_NAME_INDEX_H_
+#define SRC_DATABASE_NAME_INDEX_H_ 1
+
+#include <config.h>  // IWYU pragma: keep
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "eixTk/attribute.h"
+#include "eixTk/eixint.h"
+#include "search/levenshtein.h"
+
+/**
+The package names of the database, sorted, each with the (increasing)
+ordinal numbers of the packages of that name.
+The entries also form a BK-tree with respect to the Levenshtein distance
+(with the first entry as root) so that fuzzy searches need to compare
+only with a small part of the names.
+Exact, prefix and (with the aid of the entries sorted by reversed names)
+suffix searches are binary searches.
+**/
+class NameIndex {
+	public:
+		typedef std::vector<eix::Treesize> Packages;
+		typedef std::vector<eix::Treesize>::size_type Index;
+		typedef std::pair<Levenshtein, Index> Child;
+		typedef std::vector<Child> Children;
+
+		class Entry {
+			public:
+				std::string name;
+				Packages packages;
+				/**
+				The subtrees of the BK-tree, each with its distance
+				**/
+				Children children;
+		};
+		typedef std::vector<Entry> Entries;
+		Entries entries;
+
+		/**
+		The indices of entries sorted by the reversed names
+		**/
+		std::vector<Index> reversed;
+
+		/**
+		The sorted categories of the database. The packages of category i
+		have the ordinal numbers from category_begin[i] (inclusive) to
+		category_begin[i + 1] (exclusive)
+		**/
+		std::vector<std::string> categories;
+		Packages category_begin;
+
+		bool empty() const {
+			return entries.empty();
+		}
+
+		void clear() {
+			entries.clear();
+			reversed.clear();
+			categories.clear();
+			category_begin.clear();
+		}
+
+		/**
+		Set entries to the sorted names of packages (indexed by ordinal
+		numbers), build the BK-tree, and set reversed.
+		The categories and category_begin are taken over.
+		**/
+		void init(const std::map<std::string, Packages>& names, const std::vector<std::string>& cats, const Packages& cat_begin);
+
+		/**
+		Append the index of the entry with name s (if there is one)
+		**/
+		ATTRIBUTE_NONNULL_ void find_exact(std::vector<Index> *result, const std::string& s) const;
+
+		/**
+		Append the indices of all entries with a name beginning with prefix
+		**/
+		ATTRIBUTE_NONNULL_ void find_prefix(std::vector<Index> *result, const std::string& prefix) const;
+
+		/**
+		Append the indices of all entries with a name ending with suffix
+		**/
+		ATTRIBUTE_NONNULL_ void find_suffix(std::vector<Index> *result, const std::string& suffix) const;
+
+		/**
+		Append the indices of all categories beginning with prefix
+		**/
+		ATTRIBUTE_NONNULL_ void find_category_prefix(std::vector<Index> *result, const std::string& prefix) const;
+
+		/**
+		@return true if category exists; then its index is stored in result
+		**/
+		ATTRIBUTE_NONNULL_ bool find_category(Index *result, const std::string& category) const;
+
+		/**
+		@return true if some package of entry is in the category of index cat
+		**/
+		ATTRIBUTE_PURE bool in_category(const Entry& entry, Index cat) const;
+
+		/**
+		Append the indices of all entries with a name of distance
+		at most max from s
+		**/
+		ATTRIBUTE_NONNULL_ void find_fuzzy(std::vector<Index> *result, const char *s, Levenshtein max) const;
+};
+
+#endif  // SRC_DATABASE_NAME_INDEX_H_
@@ -21,6 +21,9 @@
 
 PackageReader::~PackageReader() {
 	delete m_pkg;
+	delete m_iuse_index;
+	delete m_revdep_index;
+	delete m_name_index;
 }
 
 bool PackageReader::read(Attributes need) {
@@ -80,6 +83,9 @@ bool PackageReader::read(Attributes need) {
 					m_pkg->addVersion(v);
 				}
 			}
+			if(unlikely(m_skip_masks)) {
+				break;
+			}
 			if(likely(m_portagesettings != NULLPTR)) {
 				m_portagesettings->calc_local_sets(m_pkg);
 				m_portagesettings->finalize(m_pkg);
@@ -137,6 +143,15 @@ bool PackageReader::next() {
 		return false;
 	}
 	m_next = m_db->tell() + len;
+	if(likely(header->version >= 39)) {
+		if(unlikely(!m_db->read_num(&m_dbflags, &m_errtext))) {
+			m_error = true;
+			return false;
+		}
+	} else {
+		m_dbflags = Package::DBFLAGS_ALL;
+	}
+	++m_count;
 	m_have = NONE;
 	delete m_pkg;
 	m_pkg = new Package;
@@ -145,6 +160,39 @@ bool PackageReader::next() {
 	return true;
 }
 
+const DBHeader::IUseIndex *PackageReader::iuse_index() {
+	if(m_iuse_index == NULLPTR) {
+		m_iuse_index = new DBHeader::IUseIndex;
+		if(unlikely(!m_db->read_iuse_index(*header, m_iuse_index, &m_errtext))) {
+			m_error = true;
+			m_iuse_index->clear();
+		}
+	}
+	return (m_iuse_index->empty() ? NULLPTR : m_iuse_index);
+}
+
+const DBHeader::RevdepIndex *PackageReader::revdep_index() {
+	if(m_revdep_index == NULLPTR) {
+		m_revdep_index = new DBHeader::RevdepIndex;
+		if(unlikely(!m_db->read_revdep_index(*header, m_revdep_index, &m_errtext))) {
+			m_error = true;
+			m_revdep_index->clear();
+		}
+	}
+	return ((header->revdep_index_offset == 0) ? NULLPTR : m_revdep_index);
+}
+
+const NameIndex *PackageReader::name_index() {
+	if(m_name_index == NULLPTR) {
+		m_name_index = new NameIndex;
+		if(unlikely(!m_db->read_name_index(*header, m_name_index, &m_errtext))) {
+			m_error = true;
+			m_name_index->clear();
+		}
+	}
+	return (m_name_index->empty() ? NULLPTR : m_name_index);
+}
+
 #if 0
 bool PackageReader::nextCategory() {
 	if(unlikely(m_frames-- == 0)) {
@@ -18,12 +18,13 @@
 #include <string>
 
 #include "database/header.h"
+#include "database/name_index.h"
 #include "eixTk/eixint.h"
 #include "eixTk/null.h"
+#include "portage/package.h"
 
 class Database;
 class DBHeader;
-class Package;
 class PortageSettings;
 
 /**
@@ -42,11 +43,11 @@ class PackageReader {
 		@arg ps is used to define the local package sets while version reading
 		**/
 		PackageReader(Database *db, const DBHeader& hdr, PortageSettings *ps)
-			: m_db(db), m_frames(hdr.size), m_cat_size(0), m_pkg(NULLPTR), header(&hdr), m_portagesettings(ps), m_error(false) {
+			: m_db(db), m_frames(hdr.size), m_cat_size(0), m_count(0), m_pkg(NULLPTR), header(&hdr), m_portagesettings(ps), m_skip_masks(false), m_iuse_index(NULLPTR), m_revdep_index(NULLPTR), m_name_index(NULLPTR), m_error(false) {
 		}
 
 		PackageReader(Database *db, const DBHeader& hdr)
-			: m_db(db), m_frames(hdr.size), m_cat_size(0), m_pkg(NULLPTR), header(&hdr), m_portagesettings(NULLPTR), m_error(false) {
+			: m_db(db), m_frames(hdr.size), m_cat_size(0), m_count(0), m_pkg(NULLPTR), header(&hdr), m_portagesettings(NULLPTR), m_skip_masks(false), m_iuse_index(NULLPTR), m_revdep_index(NULLPTR), m_name_index(NULLPTR), m_error(false) {
 		}
 
 		~PackageReader();
@@ -59,6 +60,14 @@ class PackageReader {
 			return read(ALL);
 		}
 
+		/**
+		Do not calculate masks and sets after reading versions.
+		This is useful if the versions are only copied into another tree.
+		**/
+		void skip_masks() {
+			m_skip_masks = true;
+		}
+
 		/**
 		Get pointer to the package.
 		It's possible that some attributes of the package are not yet read
@@ -100,6 +109,39 @@ class PackageReader {
 		bool nextPackage();
 #endif
 
+		/**
+		@return false if the database tells that the current package
+		has not all of flags
+		**/
+		bool dbflags(Package::DBFlags flags) const {
+			return ((m_dbflags & flags) == flags);
+		}
+
+		/**
+		@return ordinal number of the current package in the database
+		**/
+		eix::Treesize ordinal() const {
+			return m_count - 1;
+		}
+
+		/**
+		@return the IUSE index of the database (read on the first call)
+		or NULLPTR if the database has none
+		**/
+		const DBHeader::IUseIndex *iuse_index();
+
+		/**
+		@return the reverse dependency index of the database (read on the
+		first call) or NULLPTR if the database has none
+		**/
+		const DBHeader::RevdepIndex *revdep_index();
+
+		/**
+		@return the name index of the database (read on the first call)
+		or NULLPTR if the database has none
+		**/
+		const NameIndex *name_index();
+
 		/**
 		@return name of current category
 		**/
@@ -117,13 +159,19 @@ class PackageReader {
 		eix::Treesize     m_frames;
 		eix::Treesize     m_cat_size;
 		std::string       m_cat_name;
+		eix::Treesize     m_count;
 
 		off_t             m_next;
 		Attributes        m_have;
 		Package          *m_pkg;
+		Package::DBFlags  m_dbflags;
 
 		const DBHeader   *header;
 		PortageSettings  *m_portagesettings;
+		bool              m_skip_masks;
+		DBHeader::IUseIndex *m_iuse_index;
+		DBHeader::RevdepIndex *m_revdep_index;
+		NameIndex *m_name_index;
 
 		std::string m_errtext;
 		bool m_error;
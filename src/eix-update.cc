@@ -158,7 +158,7 @@ static bool
 	dump_eixrc(false),
 	dump_defaults(false);
 
-static bool use_percentage, use_status, verbose;
+static bool use_percentage, use_status, verbose, prefetch, always_accept_keywords;
 
 typedef vector<const char *> ExcludeArgs;
 typedef ExcludeArgs AddArgs;
@@ -345,6 +345,8 @@ int run_eix_update(int argc, char *argv[]) {
 
 	/* other defaults */
 	verbose = eixrc.getBool("UPDATE_VERBOSE");
+	prefetch = eixrc.getBool("UPDATE_PREFETCH");
+	always_accept_keywords = eixrc.getBool("ALWAYS_ACCEPT_KEYWORDS");
 
 	/* Setup ArgumentReader. */
 	ArgumentReader argreader(argc, argv, EixUpdateOptionList());
@@ -594,6 +596,9 @@ static bool update(const char *outputfile, CacheTable *cache_table, PortageSetti
 		if(verbose) {
 			cache->setVerbose();
 		}
+		if(prefetch) {
+			cache->setPrefetch();
+		}
 		++it;
 	}
 
@@ -663,7 +668,7 @@ static bool update(const char *outputfile, CacheTable *cache_table, PortageSetti
 	}
 	statusline->print(P_("Statusline eix-update", "Analyzing"));
 
-	/* Now apply all masks... */
+	/* Now apply all masks (and keywords for the summaries of packages)... */
 	INFO(_("Applying masks..."));
 	for(PackageTree::iterator c(package_tree.begin());
 		likely(c != package_tree.end()); ++c) {
@@ -677,8 +682,10 @@ static bool update(const char *outputfile, CacheTable *cache_table, PortageSetti
 			}
 			portage_settings->setMasks(*p);
 			p->save_maskflags(Version::SAVEMASK_FILE);
+			portage_settings->setKeyflags(*p, always_accept_keywords);
 		}
 	}
+	dbheader.always_accept_keywords = always_accept_keywords;
 
 	INFO(_("Calculating hash tables..."));
 	Database::prep_header_hashs(&dbheader, package_tree);
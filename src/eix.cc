@@ -14,12 +14,12 @@
 #include <cstdlib>
 #include <cstring>
 
-#include <algorithm>
 #include <string>
 #include <vector>
 
 #include "database/header.h"
 #include "database/io.h"
+#include "database/name_index.h"
 #include "database/package_reader.h"
 #include "eixTk/ansicolor.h"
 #include "eixTk/argsreader.h"
@@ -45,6 +45,7 @@
 #include "output/formatstring-print.h"
 #include "output/formatstring.h"
 #include "output/print-formats.h"
+#include "output/print-jsonl.h"
 #include "output/print-proto.h"
 #include "output/print-xml.h"
 #include "portage/basicversion.h"
@@ -71,6 +72,78 @@ using std::vector;
 
 typedef eix::ptr_container<vector<Package *> > PackageList;
 
+/**
+The packages of a PackageList by category and name, so that masks
+without wildcards in category or name need not scan the whole list
+**/
+class PackageIndex {
+	public:
+		typedef UNORDERED_MAP<string, const Package *> Names;
+
+		explicit PackageIndex(const PackageList& packagelist);
+
+		/**
+		@return the packages of category or NULLPTR if there are none
+		**/
+		const Names *find(const string& category) const;
+
+		/**
+		@return true if m matches some package of the list
+		**/
+		bool ismatch(const Mask& m) const;
+
+	private:
+		typedef UNORDERED_MAP<string, Names> Categories;
+		const PackageList& packages;
+		Categories categories;
+};
+
+/**
+Print the matches and collect what is needed for the overlay table
+and the summary afterwards
+**/
+class MatchPrinter {
+	public:
+		PackageList::size_type count;
+		bool have_printed, over_limit;
+		PrintFormat::OverlayUsed overlay_used;
+		bool need_overlay_table;
+
+		ATTRIBUTE_NONNULL_ MatchPrinter(DBHeader *dbheader, VarDbPkg *vardb, PortageSettings *ps, const SetStability *s, EixRc *rc, eix::Treesize max);
+
+		~MatchPrinter() {
+			finish();
+		}
+
+		/**
+		Print pkg or, if the overlays are renumbered, only collect
+		the overlays used by it
+		@return false if no further packages should be printed
+		**/
+		ATTRIBUTE_NONNULL_ bool add(Package *pkg);
+
+		/**
+		Print pkg (with the current overlay translations)
+		@return false if no further packages should be printed
+		**/
+		ATTRIBUTE_NONNULL_ bool print(Package *pkg);
+
+		/**
+		Finish the output of --xml, --proto or --jsonl
+		**/
+		void finish();
+
+	private:
+		DBHeader *header;
+		VarDbPkg *varpkg_db;
+		PortageSettings *portagesettings;
+		const SetStability *stability;
+		EixRc *eixrc;
+		eix::Treesize limit;
+		bool reached_limit;
+		PrintFormats *print_formats;
+};
+
 static void dump_help();
 ATTRIBUTE_NONNULL_ static bool opencache(Database *db, const char *filename, const char *tooltext);
 ATTRIBUTE_NONNULL((1, 2)) static bool print_overlay_table(PrintFormat *fmt, DBHeader *header, PrintFormat::OverlayUsed *overlay_used);
@@ -78,12 +151,13 @@ ATTRIBUTE_NONNULL_ static void parseFormat(const char *sourcename, const char *c
 ATTRIBUTE_NONNULL_ static void set_format(EixRc *rc);
 ATTRIBUTE_NONNULL_ static void setup_defaults(EixRc *rc, bool is_tty);
 ATTRIBUTE_NONNULL_ static bool is_current_dbversion(const char *filename, const char *tooltext);
+ATTRIBUTE_NONNULL_ static bool print_completions(const char *filename, const char *tooltext, const string& prefix);
 static void print_wordvec(const WordVec& vec);
-static void print_unused(const string& filename, const string& excludefiles, const PackageList& packagelist, bool test_empty);
-static void print_removed(const string& dirname, const string& excludefiles, const PackageList& packagelist);
-inline static void print_unused(const string& filename, const string& excludefiles, const PackageList& packagelist);
-inline static void print_unused(const string& filename, const string& excludefiles, const PackageList& packagelist) {
-	print_unused(filename, excludefiles, packagelist, false);
+static void print_unused(const string& filename, const string& excludefiles, const PackageIndex& index, bool test_empty);
+static void print_removed(const string& dirname, const string& excludefiles, const PackageIndex& index);
+inline static void print_unused(const string& filename, const string& excludefiles, const PackageIndex& index);
+inline static void print_unused(const string& filename, const string& excludefiles, const PackageIndex& index) {
+	print_unused(filename, excludefiles, index, false);
 }
 
 /**
@@ -111,6 +185,8 @@ static void dump_help() {
 "     --dump-defaults       dump default values of variables\n"
 "     --print               print the expanded value of a variable\n"
 "     --known-vars          print all variable names known to --print\n"
+"     --complete PREFIX     print package names and categories/ beginning\n"
+"                           with PREFIX (or category/name if PREFIX has /)\n"
 "     --print-all-eapis     print all EAPI used in some version\n"
 "     --print-all-useflags  print all IUSE/REQUIRED_USE used in some version\n"
 "     --print-all-keywords  print all KEYWORDS used in some version\n"
@@ -120,6 +196,7 @@ static void dump_help() {
 "                           (needs DEP=true)\n"
 "     --print-world-sets    print the world sets\n"
 "     --print-profile-paths print all paths of current profile\n"
+"     --explain             print the tests in the order they are evaluated\n"
 "     --256                 Print all ansi color palettes\n"
 "     --256d                Print ansi color palettes for foreground (dark)\n"
 "     --256d0               Print ansi color palette dark (normal)\n"
@@ -153,8 +230,12 @@ static void dump_help() {
 "     -0  --brief (toggle)   Print at most one package then stop. See -q\n"
 "                            Usually faster with COUNT_ONLY_PRINTED=false\n"
 "         --brief2 (toggle)  Print at most two packages then stop\n"
+"         --limit N          Stop after N matches (0: no limit)\n"
 "     --xml (toggle)         output results in XML format\n"
 "     --proto (toggle)       output results in protobuf format\n"
+"     --proto-stream (toggle) output each result as a length-delimited\n"
+"                            protobuf message\n"
+"     --jsonl (toggle)       output each result as a JSON object on a line\n"
 "     -c, --compact          compact search results\n"
 "     -v, --verbose          verbose search results\n"
 "     -N, --normal           ignores -c, -v, and DEFAULT_FORMAT\n"
@@ -201,6 +282,7 @@ static void dump_help() {
 "                                     provided by some overlay\n"
 "    --installed-in-overlay OVERLAY   Packages with an installed version\n"
 "                                     provided from OVERLAY\n"
+"    --rdeps CATEGORY/NAME            Packages depending on CATEGORY/NAME\n"
 "    --restrict-fetch          Match packages with RESTRICT=fetch\n"
 "    --restrict-mirror         Match packages with RESTRICT=mirror\n"
 "    --restrict-primaryuri     Match packages with RESTRICT=primaryuri\n"
@@ -278,6 +360,8 @@ static void dump_help() {
 static const char *formatstring;
 static const char *eix_cachefile(NULLPTR);
 static const char *var_to_print(NULLPTR);
+static const char *complete_prefix(NULLPTR);
+static const char *match_limit(NULLPTR);
 static const char *color(NULLPTR);
 
 enum OverlayMode {
@@ -329,7 +413,10 @@ static struct LocalOptions {
 		known_vars,
 		xml,
 		proto,
+		proto_stream,
+		jsonl,
 		test_unused,
+		explain,
 		do_debug,
 		ignore_etc_portage,
 		is_current,
@@ -381,18 +468,22 @@ EixOptionList::EixOptionList() {
 	push_back(Option("only-names",    '#',     Option::BOOLEAN,       &rc_options.only_names));
 	push_back(Option("brief",         '0',     Option::BOOLEAN,       &rc_options.brief));
 	push_back(Option("brief2",       O_BRIEF2, Option::BOOLEAN,       &rc_options.brief2));
+	push_back(Option("limit",        O_LIMIT,  Option::STRING,        &match_limit));
 
 	push_back(Option("verbose",       'v',     Option::BOOLEAN_T,     &rc_options.verbose_output));
 	push_back(Option("compact",       'c',     Option::BOOLEAN_T,     &rc_options.compact_output));
 	push_back(Option("normal",        'N',     Option::BOOLEAN_T,     &rc_options.normal_output));
 	push_back(Option("xml",           O_XML,   Option::BOOLEAN,       &rc_options.xml));
 	push_back(Option("proto",         O_PROTO, Option::BOOLEAN,       &rc_options.proto));
+	push_back(Option("proto-stream",  O_PROTO_STREAM, Option::BOOLEAN, &rc_options.proto_stream));
+	push_back(Option("jsonl",         O_JSONL, Option::BOOLEAN,       &rc_options.jsonl));
 	push_back(Option("help",          'h',     Option::BOOLEAN_T,     &rc_options.show_help));
 	push_back(Option("version",       'V',     Option::BOOLEAN_T,     &rc_options.show_version));
 	push_back(Option("dump",          O_DUMP,  Option::BOOLEAN_T,     &rc_options.dump_eixrc));
 	push_back(Option("dump-defaults", O_DUMP_DEFAULTS, Option::BOOLEAN_T, &rc_options.dump_defaults));
 	push_back(Option("known-vars",   O_KNOWN_VARS, Option::BOOLEAN_T, &rc_options.known_vars));
 	push_back(Option("test-non-matching", 't', Option::BOOLEAN_T,     &rc_options.test_unused));
+	push_back(Option("explain",       O_EXPLAIN, Option::BOOLEAN_T,   &rc_options.explain));
 	push_back(Option("debug",         O_DEBUG, Option::BOOLEAN_T,     &rc_options.do_debug));
 
 	push_back(Option("print-all-eapis",     O_HASH_EAPI,     Option::BOOLEAN_T, &rc_options.hash_eapi));
@@ -407,6 +498,7 @@ EixOptionList::EixOptionList() {
 	push_back(Option("ignore-etc-portage",  O_IGNORE_ETC_PORTAGE, Option::BOOLEAN_T,  &rc_options.ignore_etc_portage));
 
 	push_back(Option("print",               O_PRINT_VAR,    Option::STRING,     &var_to_print));
+	push_back(Option("complete",            O_COMPLETE,     Option::STRING,     &complete_prefix));
 
 	push_back(Option("format",         O_FMT,         Option::STRING,   &formatstring));
 
@@ -457,6 +549,7 @@ EixOptionList::EixOptionList() {
 	push_back(Option("only-in-overlay",      O_ONLY_OVERLAY,      Option::KEEP_STRING_OPTIONAL));
 	push_back(Option("installed-in-some-overlay", O_INSTALLED_SOME));
 	push_back(Option("installed-in-overlay", O_INSTALLED_OVERLAY, Option::KEEP_STRING_OPTIONAL));
+	push_back(Option("rdeps",                O_RDEPS,             Option::KEEP_STRING));
 	push_back(Option("restrict-fetch",         O_RESTRICT_FETCH));
 	push_back(Option("restrict-mirror",        O_RESTRICT_MIRROR));
 	push_back(Option("restrict-primaryuri",    O_RESTRICT_PRIMARYURI));
@@ -730,6 +823,11 @@ int run_eix(int argc, char** argv) {
 		return (is_current_dbversion(cachefile.c_str(), tooltext) ? EXIT_SUCCESS : EXIT_FAILURE);
 	}
 
+	// Shell completion needs only the database, not the portage settings
+	if(unlikely(complete_prefix != NULLPTR)) {
+		return (print_completions(cachefile.c_str(), tooltext, complete_prefix) ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
 	// Show version
 	if(unlikely(rc_options.show_version)) {
 		dump_version();
@@ -778,7 +876,10 @@ int run_eix(int argc, char** argv) {
 
 	bool only_printed;
 
-	if(unlikely(rc_options.xml || rc_options.proto)) {
+	if(unlikely(rc_options.proto_stream)) {
+		rc_options.proto = true;
+	}
+	if(unlikely(rc_options.xml || rc_options.proto || rc_options.jsonl)) {
 		rc_options.pure_packages = format->no_color = true;
 		only_printed = false;
 	} else {
@@ -890,7 +991,47 @@ int run_eix(int argc, char** argv) {
 
 	MatchTree *matchtree = new MatchTree(eixrc.getBool("DEFAULT_IS_OR"));
 	parse_cli(matchtree, &eixrc, &varpkg_db, &portagesettings, format, &stability, &header, parse_error, &marked_list, argreader);
+	matchtree->plan();
+	if(unlikely(rc_options.explain)) {
+		matchtree->explain();
+		delete matchtree;
+		return EXIT_SUCCESS;
+	}
 
+	// Without overlays there is nothing to renumber
+	if((overlay_mode == mode_list_used_renumbered) && (header.countOverlays() <= 1)) {
+		overlay_mode = mode_list_used;
+	}
+	format->set_marked_list(marked_list);
+	if(overlay_mode != mode_list_used_renumbered) {
+		format->set_overlay_translations(NULLPTR);
+	}
+	if(rc_options.xml || rc_options.proto || rc_options.jsonl || rc_options.be_quiet) {
+		overlay_mode = mode_list_none;
+		rc_options.pure_packages = true;
+	}
+	string limit_var(rc_options.compact_output ? "EIX_LIMIT_COMPACT" : "EIX_LIMIT");
+	eix::Treesize limit(is_tty ? eixrc.getInteger(limit_var) : 0);
+	eix::Treesize max_matches;
+	if(likely(match_limit == NULLPTR)) {
+		max_matches = eixrc.getInteger("MATCH_LIMIT");
+	} else if(likely(is_numeric(match_limit))) {
+		max_matches = static_cast<eix::Treesize>(my_atou(match_limit));
+	} else {
+		eix::say_error(_("argument of --limit must be a number: %s")) % match_limit;
+		return EXIT_FAILURE;
+	}
+	MatchPrinter printer(&header, &varpkg_db, &portagesettings, &stability, &eixrc, limit);
+
+	// Fuzzy matches are collected and sorted before --limit applies
+	bool sort_matches(FuzzyAlgorithm::sort_by_levenshtein());
+	// If the matches need not be sorted or printed twice and
+	// need not be looked ahead, print and forget them immediately
+	bool stream(likely(!rc_options.test_unused) &&
+		likely(!sort_matches) &&
+		likely(!rc_options.brief) && likely(!rc_options.brief2) &&
+		likely(overlay_mode != mode_list_used_renumbered));
+	PackageList::size_type match_count(0);
 	PackageList matches;
 	PackageList all_packages; {
 		PackageReader reader(&db, header, &portagesettings);
@@ -903,10 +1044,20 @@ int run_eix(int argc, char** argv) {
 				if(unlikely(release == NULLPTR)) {
 					break;
 				}
+				// Unless the matches are sorted, the first max_matches suffice
+				bool last((++match_count == max_matches) && likely(!sort_matches));
+				if(likely(stream)) {
+					printer.add(release);
+					delete release;
+					if(unlikely(last)) {
+						break;
+					}
+					continue;
+				}
 				matches.PUSH_BACK(release);
-				if(unlikely(only_printed &&
+				if(unlikely(last || (only_printed &&
 					(rc_options.brief ||
-						(rc_options.brief2 && (matches.size() > 1))))) {
+						(rc_options.brief2 && (matches.size() > 1)))))) {
 					if(unlikely(rc_options.test_unused)) {
 						add_rest = true;
 					} else {
@@ -940,133 +1091,81 @@ int run_eix(int argc, char** argv) {
 
 	if(unlikely(rc_options.test_unused)) {
 		bool empty(eixrc.getBool("TEST_FOR_EMPTY"));
+		PackageIndex package_index(all_packages);
 		if(likely(eixrc.getBool("TEST_KEYWORDS"))) {
 			print_unused(eixrc.m_eprefixconf + USER_KEYWORDS_FILE1,
 				eixrc["KEYWORDS_NONEXISTENT"],
-				all_packages);
+				package_index);
 			print_unused(eixrc.m_eprefixconf + USER_KEYWORDS_FILE2,
 				eixrc["KEYWORDS_NONEXISTENT"],
-				all_packages);
+				package_index);
 		}
 		if(likely(eixrc.getBool("TEST_MASK"))) {
 			print_unused(eixrc.m_eprefixconf + USER_MASK_FILE,
 				eixrc["MASK_NONEXISTENT"],
-				all_packages);
+				package_index);
 		}
 		if(likely(eixrc.getBool("TEST_UNMASK"))) {
 			print_unused(eixrc.m_eprefixconf + USER_UNMASK_FILE,
 				eixrc["UNMASK_NONEXISTENT"],
-				all_packages);
+				package_index);
 		}
 		if(likely(eixrc.getBool("TEST_USE"))) {
 			print_unused(eixrc.m_eprefixconf + USER_USE_FILE,
 				eixrc["USE_NONEXISTENT"],
-				all_packages, empty);
+				package_index, empty);
 		}
 		if(likely(eixrc.getBool("TEST_ENV"))) {
 			print_unused(eixrc.m_eprefixconf + USER_ENV_FILE,
 				eixrc["ENV_NONEXISTENT"],
-				all_packages, empty);
+				package_index, empty);
 		}
 		if(likely(eixrc.getBool("TEST_LICENSE"))) {
 			print_unused(eixrc.m_eprefixconf + USER_LICENSE_FILE,
 				eixrc["LICENSE_NONEXISTENT"],
-				all_packages, empty);
+				package_index, empty);
 		}
 		if(likely(eixrc.getBool("TEST_RESTRICT"))) {
 			print_unused(eixrc.m_eprefixconf + USER_RESTRICT_FILE,
 				eixrc["LICENSE_RESTRICT"],
-				all_packages, empty);
+				package_index, empty);
 		}
 		if(likely(eixrc.getBool("TEST_CFLAGS"))) {
 			print_unused(eixrc.m_eprefixconf + USER_CFLAGS_FILE,
 				eixrc["CFLAGS_NONEXISTENT"],
-				all_packages, empty);
+				package_index, empty);
 		}
 		if(likely(eixrc.getBool("TEST_REMOVED"))) {
-			print_removed(var_db_pkg, eixrc["INSTALLED_NONEXISTENT"], all_packages);
+			print_removed(var_db_pkg, eixrc["INSTALLED_NONEXISTENT"], package_index);
 		}
 	}
 
 	/* Sort the found matches by rating */
-	if(unlikely(FuzzyAlgorithm::sort_by_levenshtein())) {
-		std::sort(matches.begin(), matches.end(), FuzzyAlgorithm::compare);
-	}
-
-	format->set_marked_list(marked_list);
-	if(overlay_mode != mode_list_used_renumbered) {
-		format->set_overlay_translations(NULLPTR);
-	}
-	bool need_overlay_table(false);
-	PrintFormat::OverlayUsed overlay_used(header.countOverlays(), false);
-	format->set_overlay_used(&overlay_used, &need_overlay_table);
-	PackageList::size_type count(0);
-	PrintFormats *print_formats(NULLPTR);
-	if(rc_options.xml || rc_options.proto || rc_options.be_quiet) {
-		overlay_mode = mode_list_none;
-		rc_options.pure_packages = true;
-	}
-	if (!matches.empty()) {
-		if(rc_options.xml) {
-			if (unlikely(rc_options.proto)) {
-				eix::say_error(_("--xml and --proto must not be specified simultaneously"));
-				std::exit(EXIT_FAILURE);
-			}
-			print_formats = new PrintXml(&header, &varpkg_db, format, &stability, &eixrc,
-				portagesettings["PORTDIR"]);
-		} else if (rc_options.proto) {
-			print_formats = new PrintProto(&header, &varpkg_db, format, &stability);
-		}
-		if (print_formats != NULLPTR) {
-			print_formats->start();
+	if(unlikely(sort_matches)) {
+		FuzzyAlgorithm::sort_by_distance(&matches);
+		if(unlikely((max_matches != 0) && (matches.size() > max_matches))) {
+			do {
+				if(likely(!rc_options.test_unused)) {
+					delete matches.back();
+				}
+				matches.pop_back();
+			} while(matches.size() > max_matches);
+			match_count = max_matches;
 		}
 	}
-	bool have_printed(false);
-	bool reached_limit(false), over_limit(false);
-	string limit_var(rc_options.compact_output ? "EIX_LIMIT_COMPACT" : "EIX_LIMIT");
-	eix::Treesize limit(is_tty ? eixrc.getInteger(limit_var) : 0);
+
 	for(PackageList::iterator it(matches.begin());
 		likely(it != matches.end()); ++it) {
-		stability.set_stability(*it);
-
-		if(unlikely(print_formats != NULLPTR)) {
-			print_formats->package(*it);
-			continue;
-		}
-
-		if(it->largest_overlay != 0) {
-			need_overlay_table = true;
-			if(overlay_mode <= mode_list_used) {
-				for(Package::iterator ver(it->begin());
-					likely(ver != it->end()); ++ver) {
-					ExtendedVersion::Overlay key(ver->overlay_key);
-					if(key > 0) {
-						overlay_used[key - 1] = true;
-					}
-				}
-			}
-		}
-		if(overlay_mode != mode_list_used_renumbered) {
-			if(format->print(*it, &header, &varpkg_db, &portagesettings, &stability, reached_limit)) {
-				have_printed = true;
-				++count;
-				if(unlikely(reached_limit)) {
-					over_limit = true;
-				} else if(unlikely(count == limit)) {
-					reached_limit = true;
-				}
-				if(unlikely(rc_options.brief || (rc_options.brief2 && count > 1))) {
-					break;
-				}
-			}
+		if(!printer.add(*it)) {
+			break;
 		}
 	}
 	switch(overlay_mode) {
 		case mode_list_all:
-			need_overlay_table = true;
+			printer.need_overlay_table = true;
 			break;
 		case mode_list_none:
-			need_overlay_table = false;
+			printer.need_overlay_table = false;
 			break;
 		default:
 			break;
@@ -1074,9 +1173,9 @@ int run_eix(int argc, char** argv) {
 	PrintFormat::OverlayTranslations overlay_num(header.countOverlays(), 0);
 	if(overlay_mode == mode_list_used_renumbered) {
 		ExtendedVersion::Overlay i(1);
-		PrintFormat::OverlayUsed::iterator uit(overlay_used.begin());
+		PrintFormat::OverlayUsed::iterator uit(printer.overlay_used.begin());
 		PrintFormat::OverlayTranslations::iterator nit(overlay_num.begin());
-		for(; likely(uit != overlay_used.end()); ++uit, ++nit) {
+		for(; likely(uit != printer.overlay_used.end()); ++uit, ++nit) {
 			if(*uit == true) {
 				*nit = i++;
 			}
@@ -1084,35 +1183,22 @@ int run_eix(int argc, char** argv) {
 		format->set_overlay_translations(&overlay_num);
 		for(PackageList::iterator it(matches.begin());
 			likely(it != matches.end()); ++it) {
-			if(format->print(*it, &header, &varpkg_db, &portagesettings, &stability, reached_limit)) {
-				have_printed = true;
-				++count;
-				if(unlikely(reached_limit)) {
-					over_limit = true;
-				} else if(unlikely(count == limit)) {
-					reached_limit = true;
-				}
-				if(unlikely(rc_options.brief || (rc_options.brief2 && count > 1))) {
-					break;
-				}
+			if(!printer.print(*it)) {
+				break;
 			}
 		}
 	}
+	bool have_printed(printer.have_printed);
 	bool printed_overlay(false);
-	if(need_overlay_table) {
+	if(printer.need_overlay_table) {
 		if(print_overlay_table(format, &header,
-			(overlay_mode <= mode_list_used)? &overlay_used : NULLPTR)) {
+			(overlay_mode <= mode_list_used)? &printer.overlay_used : NULLPTR)) {
 			printed_overlay = have_printed = true;
 		}
 	}
-	if(unlikely(print_formats != NULLPTR)) {
-		print_formats->finish();
-		delete print_formats;
-	}
+	printer.finish();
 
-	if(!only_printed) {
-		count = matches.size();
-	}
+	PackageList::size_type count(only_printed ? printer.count : match_count);
 	eix::SignedBool print_count_always(rc_options.pure_packages ? -1 :
 		eixrc.getBoolText("PRINT_COUNT_ALWAYS", "never"));
 	if(likely(print_count_always >= 0)) {
@@ -1137,7 +1223,7 @@ int run_eix(int argc, char** argv) {
 	}
 	if(likely(have_printed)) {
 		eix::print() % format->color_end;
-		if(unlikely(over_limit)) {
+		if(unlikely(printer.over_limit)) {
 			eix::say(N_(
 			"Only %s match displayed on terminal\n"
 			"Set %s=0 to show all matches",
@@ -1190,6 +1276,102 @@ static bool is_current_dbversion(const char *filename, const char *tooltext) {
 	return db.read_header(&header, NULLPTR, 0);
 }
 
+ATTRIBUTE_PURE static bool has_prefix(const string& s, const string& prefix);
+static bool has_prefix(const string& s, const string& prefix) {
+	return (s.compare(0, prefix.size(), prefix) == 0);
+}
+
+/**
+Print the package names and the categories (with a trailing slash)
+beginning with prefix, or category/name if prefix contains a slash.
+The name index of the database is used so that packages need not be read
+**/
+static bool print_completions(const char *filename, const char *tooltext, const string& prefix) {
+	Database db;
+	if(unlikely(!opencache(&db, filename, tooltext))) {
+		return false;
+	}
+	DBHeader header;
+	if(unlikely(!db.read_header(&header, NULLPTR, 0))) {
+		return false;
+	}
+	string::size_type slash(prefix.find('/'));
+	string category, name_prefix(prefix);
+	if(slash != string::npos) {
+		category.assign(prefix, 0, slash);
+		name_prefix.erase(0, slash + 1);
+	}
+	PackageReader reader(&db, header);
+	const NameIndex *index(reader.name_index());
+	WordSet completions;
+	if(likely(index != NULLPTR)) {
+		// Binary searches in the name index suffice
+		vector<NameIndex::Index> found;
+		index->find_prefix(&found, name_prefix);
+		if(slash == string::npos) {
+			vector<NameIndex::Index> categories;
+			index->find_category_prefix(&categories, prefix);
+			for(vector<NameIndex::Index>::const_iterator it(categories.begin());
+				likely(it != categories.end()); ++it) {
+				completions.INSERT(index->categories[*it] + "/");
+			}
+			for(vector<NameIndex::Index>::const_iterator it(found.begin());
+				likely(it != found.end()); ++it) {
+				completions.INSERT(index->entries[*it].name);
+			}
+		} else {
+			NameIndex::Index cat;
+			if(index->find_category(&cat, category)) {
+				for(vector<NameIndex::Index>::const_iterator it(found.begin());
+					likely(it != found.end()); ++it) {
+					const NameIndex::Entry& entry(index->entries[*it]);
+					if(index->in_category(entry, cat)) {
+						completions.INSERT(category + "/" + entry.name);
+					}
+				}
+			}
+		}
+	} else {
+		// Databases without name index must be read
+		string last_category;
+		while(reader.next()) {
+			const string& curr_category(reader.category());
+			if(slash == string::npos) {
+				if(curr_category != last_category) {
+					last_category = curr_category;
+					if(has_prefix(curr_category, prefix)) {
+						completions.INSERT(curr_category + "/");
+					}
+				}
+			} else if(curr_category != category) {
+				if(unlikely(!reader.skip())) {
+					break;
+				}
+				continue;
+			}
+			if(likely(reader.read(PackageReader::NAME))) {
+				const string& curr_name(reader.get()->name);
+				if(has_prefix(curr_name, name_prefix)) {
+					completions.INSERT((slash == string::npos) ? curr_name : (category + "/" + curr_name));
+				}
+			}
+			if(unlikely(!reader.skip())) {
+				break;
+			}
+		}
+	}
+	const char *err_cstr(reader.get_errtext());
+	if(unlikely(err_cstr != NULLPTR)) {
+		eix::say_error() % err_cstr;
+		return false;
+	}
+	for(WordSet::const_iterator it(completions.begin());
+		likely(it != completions.end()); ++it) {
+		eix::say() % (*it);
+	}
+	return true;
+}
+
 static void print_wordvec(const WordVec& vec) {
 	for(WordVec::const_iterator it(vec.begin());
 		likely(it != vec.end()); ++it) {
@@ -1198,7 +1380,122 @@ static void print_wordvec(const WordVec& vec) {
 	eix::say("--");
 }
 
-static void print_unused(const string& filename, const string& excludefiles, const PackageList& packagelist, bool test_empty) {
+PackageIndex::PackageIndex(const PackageList& packagelist) : packages(packagelist) {
+	for(PackageList::const_iterator it(packagelist.begin());
+		likely(it != packagelist.end()); ++it) {
+		categories[it->category][it->name] = *it;
+	}
+}
+
+const PackageIndex::Names *PackageIndex::find(const string& category) const {
+	Categories::const_iterator it(categories.find(category));
+	return ((it == categories.end()) ? NULLPTR : &(it->second));
+}
+
+bool PackageIndex::ismatch(const Mask& m) const {
+	static const char wildcards[] = "*?[\\";
+	if(unlikely(std::strpbrk(m.getCategory(), wildcards) != NULLPTR)) {
+		for(PackageList::const_iterator it(packages.begin());
+			likely(it != packages.end()); ++it) {
+			if(m.ismatch(**it)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	const Names *names(find(m.getCategory()));
+	if(names == NULLPTR) {
+		return false;
+	}
+	if(unlikely(std::strpbrk(m.getName(), wildcards) != NULLPTR)) {
+		for(Names::const_iterator it(names->begin());
+			likely(it != names->end()); ++it) {
+			if(m.ismatch(*(it->second))) {
+				return true;
+			}
+		}
+		return false;
+	}
+	Names::const_iterator it(names->find(m.getName()));
+	return ((it != names->end()) && m.ismatch(*(it->second)));
+}
+
+MatchPrinter::MatchPrinter(DBHeader *dbheader, VarDbPkg *vardb, PortageSettings *ps, const SetStability *s, EixRc *rc, eix::Treesize max) :
+	count(0), have_printed(false), over_limit(false),
+	overlay_used(dbheader->countOverlays(), false), need_overlay_table(false),
+	header(dbheader), varpkg_db(vardb), portagesettings(ps), stability(s),
+	eixrc(rc), limit(max), reached_limit(false), print_formats(NULLPTR) {
+	format->set_overlay_used(&overlay_used, &need_overlay_table);
+}
+
+bool MatchPrinter::add(Package *pkg) {
+	stability->set_stability(pkg);
+	if(unlikely((print_formats == NULLPTR) &&
+		(rc_options.xml || rc_options.proto || rc_options.jsonl))) {
+		if(unlikely(rc_options.jsonl)) {
+			if(unlikely(rc_options.xml || rc_options.proto)) {
+				eix::say_error(_("--jsonl must not be combined with --xml or --proto"));
+				std::exit(EXIT_FAILURE);
+			}
+			print_formats = new PrintJsonl(header, varpkg_db, format, stability);
+		} else if(rc_options.xml) {
+			if(unlikely(rc_options.proto)) {
+				eix::say_error(_("--xml and --proto must not be specified simultaneously"));
+				std::exit(EXIT_FAILURE);
+			}
+			print_formats = new PrintXml(header, varpkg_db, format, stability, eixrc,
+				(*portagesettings)["PORTDIR"]);
+		} else {
+			print_formats = new PrintProto(header, varpkg_db, format, stability, rc_options.proto_stream);
+		}
+		print_formats->start();
+	}
+	if(unlikely(print_formats != NULLPTR)) {
+		print_formats->package(pkg);
+		return true;
+	}
+
+	if(pkg->largest_overlay != 0) {
+		need_overlay_table = true;
+		if(overlay_mode <= mode_list_used) {
+			for(Package::iterator ver(pkg->begin());
+				likely(ver != pkg->end()); ++ver) {
+				ExtendedVersion::Overlay key(ver->overlay_key);
+				if(key > 0) {
+					overlay_used[key - 1] = true;
+				}
+			}
+		}
+	}
+	if(overlay_mode == mode_list_used_renumbered) {
+		return true;
+	}
+	return print(pkg);
+}
+
+bool MatchPrinter::print(Package *pkg) {
+	if(!format->print(pkg, header, varpkg_db, portagesettings, stability, reached_limit)) {
+		return true;
+	}
+	have_printed = true;
+	++count;
+	if(unlikely(reached_limit)) {
+		over_limit = true;
+	} else if(unlikely(count == limit)) {
+		reached_limit = true;
+	}
+	return !(rc_options.brief || (rc_options.brief2 && (count > 1)));
+}
+
+void MatchPrinter::finish() {
+	if(unlikely(print_formats != NULLPTR)) {
+		print_formats->finish();
+		delete print_formats;
+		print_formats = NULLPTR;
+	}
+}
+
+static void print_unused(const string& filename, const string& excludefiles, const PackageIndex& index, bool test_empty) {
 	WordVec unused;
 	LineVec lines;
 	WordSet excludes;
@@ -1245,13 +1542,7 @@ static void print_unused(const string& filename, const string& excludefiles, con
 			parse_error->output(filename, lines.begin(), i, errtext);
 			continue;
 		}
-		PackageList::const_iterator pi(packagelist.begin());
-		for( ; likely(pi != packagelist.end()); ++pi) {
-			if(m.ismatch(**pi)) {
-				break;
-			}
-		}
-		if(pi != packagelist.end()) {
+		if(index.ismatch(m)) {
 			continue;
 		}
 		unused.PUSH_BACK(MOVE(*i));
@@ -1270,15 +1561,7 @@ static void print_unused(const string& filename, const string& excludefiles, con
 	print_wordvec(unused);
 }
 
-static void print_removed(const string& dirname, const string& excludefiles, const PackageList& packagelist) {
-	/* For faster testing, we build a category->name map */
-	typedef UNORDERED_MAP<string, WordUnorderedSet> CatName;
-	CatName cat_name;
-	for(PackageList::const_iterator pit(packagelist.begin());
-		likely(pit != packagelist.end()); ++pit) {
-		cat_name[pit->category].INSERT(pit->name);
-	}
-
+static void print_removed(const string& dirname, const string& excludefiles, const PackageIndex& index) {
 	/* This will contain categories/packages to be printed */
 	WordVec failure;
 
@@ -1293,8 +1576,7 @@ static void print_removed(const string& dirname, const string& excludefiles, con
 		string cat_slash(*cit);
 		cat_slash.append(1, '/');
 		pushback_files(dirname + cat_slash, &names, NULLPTR, 2, true, false);
-		CatName::const_iterator cat(cat_name.find(*cit));
-		const WordIterateSet *ns((cat == cat_name.end()) ? NULLPTR : &(cat->second));
+		const PackageIndex::Names *ns(index.find(*cit));
 		for(WordVec::const_iterator nit(names.begin());
 			likely(nit != names.end()); ++nit) {
 			string curr_name;
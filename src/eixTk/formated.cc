@@ -9,6 +9,7 @@
 #include "eixTk/formated.h"
 #include <config.h>  // IWYU pragma: keep
 
+#include <cerrno>
 #include <cstdio>
 #include <cstdlib>
 
@@ -27,6 +28,8 @@ using std::string;
 
 namespace eix {
 
+static void check_pipe();
+
 const FormatManip::ArgType
 	FormatManip::NONE,
 	FormatManip::STRING,
@@ -150,13 +153,27 @@ void format::newline_output() {
 		m_text.append(1, '\n');
 	}
 	if(output != NULLPTR) {
-		if(likely(!m_text.empty())) {
-			std::fwrite(m_text.c_str(), sizeof(char),  m_text.size(), output);
-		}
+		write_output(output, m_text);
 		if(unlikely(do_flush)) {
-			std::fflush(output);
+			if(unlikely(std::fflush(output) != 0)) {
+				check_pipe();
+			}
 		}
 	}
 }
 
+void write_output(FILE *stream, const char *s, string::size_type len) {
+	if(likely(len != 0) &&
+		unlikely(std::fwrite(s, sizeof(char), len, stream) != len)) {
+		check_pipe();
+	}
+}
+
+static void check_pipe() {
+	// The reader has gone (e.g. eix ... | head): Further output is useless
+	if(errno == EPIPE) {
+		std::exit(EXIT_SUCCESS);
+	}
+}
+
 }/* namespace eix */
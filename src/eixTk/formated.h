@@ -116,6 +116,17 @@ class FormatReplace {
 		std::string s, d;
 };
 
+/**
+Write the unformatted text s of length len to stream.
+If the reader of a pipe has gone, exit immediately.
+**/
+ATTRIBUTE_NONNULL_ void write_output(FILE *stream, const char *s, std::string::size_type len);
+
+ATTRIBUTE_NONNULL_ inline static void write_output(FILE *stream, const std::string& s);
+inline static void write_output(FILE *stream, const std::string& s) {
+	write_output(stream, s.c_str(), s.size());
+}
+
 class format {
 	protected:
 		typedef FormatManip::ArgType ArgType;
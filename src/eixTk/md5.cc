@@ -10,21 +10,19 @@
 #include <config.h>  // IWYU pragma: keep
 
 #include <fcntl.h>
-#include <sys/mman.h>
-#include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <cerrno>
+
 #include <string>
 
 #include "eixTk/attribute.h"
-#include "eixTk/diagnostics.h"
 #include "eixTk/dialect.h"
 #ifdef DEBUG_MD5
 #include "eixTk/formated.h"
 #endif
 #include "eixTk/inttypes.h"
-#include "eixTk/null.h"
 
 using std::string;
 
@@ -35,9 +33,13 @@ inline static uint32_t md5G(uint32_t x, uint32_t y, uint32_t z);
 inline static uint32_t md5H(uint32_t x, uint32_t y, uint32_t z);
 inline static uint32_t md5I(uint32_t x, uint32_t y, uint32_t z);
 inline static uint32_t md5rotate(uint32_t x, unsigned int c);
+inline static uint32_t md5byte(const char *buffer, unsigned int i, unsigned int shift);
 ATTRIBUTE_NONNULL_ static void md5fill(const char *buffer, uint32_t *mybuf, unsigned int len);
 ATTRIBUTE_NONNULL_ static void md5chunk(const uint32_t *mybuf, uint32_t *resarr);
-ATTRIBUTE_NONNULL_ static void calc_md5sum(const char *buffer, Md5DataLen totalsize, uint32_t *resarr);
+ATTRIBUTE_NONNULL_ static void md5blocks(const char *buffer, Md5DataLen blocks, uint32_t *resarr);
+ATTRIBUTE_NONNULL_ static void md5final(const char *buffer, unsigned int restsize, Md5DataLen totalsize, uint32_t *resarr);
+ATTRIBUTE_NONNULL_ static bool calc_md5sum(int fd, uint32_t *resarr);
+ATTRIBUTE_NONNULL_ static bool parse_md5sum(const string& md5sum, uint32_t *resarr);
 
 inline static uint32_t md5F(uint32_t x, uint32_t y, uint32_t z) {
 	return (x & y) | ((~x) & z);
@@ -109,13 +111,19 @@ static CONSTEXPR const uint32_t md5init[4] = {
 	0x67452301UL, 0xEFCDAB89UL, 0x98BADCFEUL, 0x10325476UL
 };
 
+/**
+Bytes must be taken unsigned: Otherwise, a non-ASCII character would
+set all higher bits of the word and the checksum would never match.
+**/
+inline static uint32_t md5byte(const char *buffer, unsigned int i, unsigned int shift) {
+	return static_cast<uint32_t>(static_cast<unsigned char>(buffer[i])) << shift;
+}
+
 static void md5fill(const char *buffer, uint32_t *mybuf, unsigned int len) {
 	while(len != 0) {
 		*(mybuf++) =
-			(static_cast<uint32_t>(buffer[3]) << 24) +
-			(static_cast<uint32_t>(buffer[2]) << 16) +
-			(static_cast<uint32_t>(buffer[1]) << 8) +
-			static_cast<uint32_t>(buffer[0]);
+			md5byte(buffer, 3, 24) | md5byte(buffer, 2, 16) |
+			md5byte(buffer, 1, 8) | md5byte(buffer, 0, 0);
 		buffer += 4;
 		--len;
 	}
@@ -178,37 +186,35 @@ static void md5chunk(const uint32_t *mybuf, uint32_t *resarr) {
 	resarr[3] = (resarr[3] + d) & 0xFFFFFFFFUL;
 }
 
-static void calc_md5sum(const char *buffer, Md5DataLen totalsize, uint32_t *resarr) {
-	resarr[0] = md5init[0];
-	resarr[1] = md5init[1];
-	resarr[2] = md5init[2];
-	resarr[3] = md5init[3];
+static void md5blocks(const char *buffer, Md5DataLen blocks, uint32_t *resarr) {
 	uint32_t mybuf[16];
-	Md5DataLen restsize(totalsize);
-	while(restsize >= 64) {
+	for(; blocks != 0; --blocks) {
 		md5fill(buffer, mybuf, 16);
 		md5chunk(mybuf, resarr);
-		restsize -= 64;
 		buffer += 64;
 	}
+}
+
+/**
+Process the last restsize < 64 bytes and the padding
+**/
+static void md5final(const char *buffer, unsigned int restsize, Md5DataLen totalsize, uint32_t *resarr) {
+	uint32_t mybuf[16];
 	unsigned int len(restsize/4);
 	md5fill(buffer, mybuf, len);
 	buffer += 4 * len;
 	switch(restsize % 4) {
 		case 3:
-			mybuf[len] = (0x80UL << 24) +
-				(static_cast<uint32_t>(buffer[2]) << 16) +
-				(static_cast<uint32_t>(buffer[1]) << 8) +
-				static_cast<uint32_t>(buffer[0]);
+			mybuf[len] = (0x80UL << 24) |
+				md5byte(buffer, 2, 16) | md5byte(buffer, 1, 8) |
+				md5byte(buffer, 0, 0);
 			break;
 		case 2:
-			mybuf[len] = (0x80UL << 16) +
-				(static_cast<uint32_t>(buffer[1]) << 8) +
-				static_cast<uint32_t>(buffer[0]);
+			mybuf[len] = (0x80UL << 16) |
+				md5byte(buffer, 1, 8) | md5byte(buffer, 0, 0);
 			break;
 		case 1:
-			mybuf[len] = (0x80UL << 8) +
-				static_cast<uint32_t>(buffer[0]);
+			mybuf[len] = (0x80UL << 8) | md5byte(buffer, 0, 0);
 			break;
 		/* case 0: */
 		default:
@@ -230,6 +236,74 @@ static void calc_md5sum(const char *buffer, Md5DataLen totalsize, uint32_t *resa
 	md5chunk(mybuf, resarr);
 }
 
+/**
+Read the file in chunks into a fixed buffer: For files of the size of
+an ebuild this is cheaper than mapping them, and memory stays constant.
+**/
+static bool calc_md5sum(int fd, uint32_t *resarr) {
+	resarr[0] = md5init[0];
+	resarr[1] = md5init[1];
+	resarr[2] = md5init[2];
+	resarr[3] = md5init[3];
+	char buffer[64 * 256];
+	Md5DataLen totalsize(0);
+	for(;;) {
+		// Fill the buffer completely unless we reach EOF
+		Md5DataLen filled(0);
+		while(filled < sizeof(buffer)) {
+			ssize_t r(read(fd, buffer + filled, sizeof(buffer) - filled));
+			if(r == 0) {
+				break;
+			}
+			if(r < 0) {
+				if(errno == EINTR) {
+					continue;
+				}
+				return false;
+			}
+			filled += static_cast<Md5DataLen>(r);
+		}
+		totalsize += filled;
+		md5blocks(buffer, filled / 64, resarr);
+		if(filled != sizeof(buffer)) {
+			md5final(buffer + (filled & ~static_cast<Md5DataLen>(63)),
+				static_cast<unsigned int>(filled % 64), totalsize, resarr);
+			return true;
+		}
+	}
+}
+
+/**
+Convert the hex string md5sum into the words computed by calc_md5sum
+@return false if md5sum is not a valid md5sum
+**/
+static bool parse_md5sum(const string& md5sum, uint32_t *resarr) {
+	if(md5sum.size() != 32) {
+		return false;
+	}
+	string::size_type curr(0);
+	for(int i(0); i < 4; ++i) {
+		uint32_t res(0);
+		for(unsigned int j(0); j < 8; ++j) {
+			char c(md5sum[curr++]);
+			uint32_t nibble;
+			if((c >= '0') && (c <= '9')) {
+				nibble = static_cast<uint32_t>(c - '0');
+			} else if((c >= 'a') && (c <= 'f')) {
+				nibble = static_cast<uint32_t>(c - 'a' + 10);
+			} else if((c >= 'A') && (c <= 'F')) {
+				nibble = static_cast<uint32_t>(c - 'A' + 10);
+			} else {
+				return false;
+			}
+			// Hex digits come in pairs, lower-order byte first
+			res |= nibble << (((j & 1) == 0) ? (4 * j + 4) : (4 * j - 4));
+		}
+		resarr[i] = res;
+	}
+	return true;
+}
+
 #ifdef DEBUG_MD5
 
 ATTRIBUTE_NONNULL_ static void debug_md5(const uint32_t *resarr);
@@ -258,70 +332,24 @@ static void debug_md5(const uint32_t *resarr) {
 #endif
 
 bool verify_md5sum(const char *file, const string& md5sum) {
-	if(md5sum.size() != 32) {
+	uint32_t expected[4];
+	if(!parse_md5sum(md5sum, expected)) {
 		return false;
 	}
-	if(md5sum.find_first_not_of("0123456789abcdefABCDEF") != string::npos) {
-		return false;
-	}
-	char *filebuffer(NULLPTR);
 	int fd(open(file, O_RDONLY));
 	if(fd == -1) {
 		return false;
 	}
-	Md5DataLen filesize; {
-		struct stat st;
-		if(fstat(fd, &st)) {
-			close(fd);
-			return false;
-		}
-GCC_DIAG_OFF(sign-conversion)
-		filesize = st.st_size;
-GCC_DIAG_ON(sign-conversion)
-	}
-	if(filesize != 0) {
-		filebuffer = static_cast<char *>(mmap(NULLPTR, filesize, PROT_READ, MAP_SHARED, fd, 0));
-		close(fd);
-GCC_DIAG_OFF(old-style-cast)
-		if(filebuffer == MAP_FAILED) {
-GCC_DIAG_ON(old-style-cast)
-			return false;
-		}
-	}
 	uint32_t resarr[4];
-	calc_md5sum(filebuffer, filesize, resarr);
-	if(filebuffer != NULLPTR) {
-		munmap(filebuffer, filesize);
+	bool ok(calc_md5sum(fd, resarr));
+	close(fd);
+	if(!ok) {
+		return false;
 	}
 #ifdef DEBUG_MD5
-	eix::print("file: %s size: %s should be: %s is: ")
-		% file % filesize % md5sum;
+	eix::print("file: %s should be: %s is: ") % file % md5sum;
 	debug_md5(resarr);
 #endif
-	string::size_type curr(0);
-	for(int i(0); i < 4; ++i) {
-		uint32_t res(resarr[i]);
-		for(int j(0); j < 8; ++j) {
-			char c;
-			if((j & 1) == 0) {
-				c = ((res / 16) % 16);
-			} else {
-				c = (res % 16);
-				res /= 256;
-			}
-			if(c < 10) {
-				if(md5sum[curr] != ('0' + c)) {
-					return false;
-				}
-			} else {
-				c -= 10;
-				if(	(md5sum[curr] != ('a' + c)) &&
-					(md5sum[curr] != ('A' + c)) ) {
-					return false;
-				}
-			}
-			++curr;
-		}
-	}
-	return true;
+	return ((resarr[0] == expected[0]) && (resarr[1] == expected[1]) &&
+		(resarr[2] == expected[2]) && (resarr[3] == expected[3]));
 }
@@ -8,6 +8,7 @@
 #include "eixTk/outputstring.h"
 #include <config.h>  // IWYU pragma: keep
 
+#include <cstdio>
 #include <cstring>
 
 #include <string>
@@ -275,7 +276,16 @@ void OutputString::print(std::string *dest, WordSize *s) const {
 }
 
 void OutputString::print(WordSize *s) const {
+	if(likely(m_insert.empty())) {
+		eix::write_output(stdout, m_string);
+		if(unlikely(absolute)) {
+			*s = m_size;
+		} else {
+			*s += m_size;
+		}
+		return;
+	}
 	string d;
 	print(&d, s);
-	eix::print() % d;
+	eix::write_output(stdout, d);
 }
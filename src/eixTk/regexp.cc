@@ -11,10 +11,13 @@
 #include <config.h>  // IWYU pragma: keep
 
 #include <cstdlib>
+#include <cstring>
 
 #include <string>
 #include <vector>
 
+#include "eixTk/assert.h"
+#include "eixTk/attribute.h"
 #include "eixTk/diagnostics.h"
 #include "eixTk/dialect.h"
 #include "eixTk/formated.h"
@@ -26,6 +29,77 @@
 using std::string;
 using std::vector;
 
+ATTRIBUTE_NONNULL_ ATTRIBUTE_PURE static const char *skip_bracket(const char *p);
+ATTRIBUTE_NONNULL_ ATTRIBUTE_PURE static const char *skip_group(const char *p);
+ATTRIBUTE_NONNULL_ static void end_run(string *curr, string *best);
+
+/**
+@return pointer to the closing ']' of the bracket expression at p
+**/
+static const char *skip_bracket(const char *p) {
+	++p;
+	if(*p == '^') {
+		++p;
+	}
+	if(*p == ']') {
+		++p;
+	}
+	for(; *p != ']'; ++p) {
+		if(unlikely(*p == '\0')) {
+			return NULLPTR;
+		}
+		if((*p == '[') && ((p[1] == ':') || (p[1] == '.') || (p[1] == '='))) {
+			const char end[3] = { p[1], ']', '\0' };
+			p = std::strstr(p + 2, end);
+			if(unlikely(p == NULLPTR)) {
+				return NULLPTR;
+			}
+			++p;
+		}
+	}
+	return p;
+}
+
+/**
+@return pointer to the ')' closing the group at p
+**/
+static const char *skip_group(const char *p) {
+	unsigned int depth(0);
+	for(; *p != '\0'; ++p) {
+		switch(*p) {
+			case '\\':
+				if(unlikely(*(++p) == '\0')) {
+					return NULLPTR;
+				}
+				break;
+			case '[':
+				p = skip_bracket(p);
+				if(unlikely(p == NULLPTR)) {
+					return NULLPTR;
+				}
+				break;
+			case '(':
+				++depth;
+				break;
+			case ')':
+				if(--depth == 0) {
+					return p;
+				}
+				break;
+			default:
+				break;
+		}
+	}
+	return NULLPTR;
+}
+
+static void end_run(string *curr, string *best) {
+	if(curr->size() > best->size()) {
+		best->swap(*curr);
+	}
+	curr->clear();
+}
+
 /**
 Free the regular expression
 **/
@@ -56,6 +130,150 @@ void Regex::compile(const char *regex, int eflags) {
 		std::exit(EXIT_FAILURE);
 	}
 	m_compiled = true;
+	m_icase = ((eflags & REG_ICASE) != 0);
+	analyse(regex);
+}
+
+/**
+Find the longest string of literal characters which every match must
+contain. The analysis is conservative: Anything not understood only
+ends the current string of literals, and alternatives give up.
+Only ASCII characters are taken as literals.
+**/
+void Regex::analyse(const char *regex) {
+	m_literal_mode = LIT_NONE;
+	m_literal.clear();
+	string curr, best;
+	bool exact(true), anchor_begin(false), anchor_end(false);
+	bool last_literal(false);  // was the last atom appended to curr?
+	for(const char *p(regex); likely(*p != '\0'); ++p) {
+		char c(*p);
+		bool literal(false);
+		switch(c) {
+			case '|':
+			case ')':
+				return;
+			case '^':
+				if(p != regex) {
+					exact = false;
+				}
+				anchor_begin = true;
+				break;
+			case '$':
+				if(p[1] != '\0') {
+					exact = false;
+				}
+				anchor_end = true;
+				break;
+			case '*':
+			case '?':
+			case '{':
+			case '+': {
+					// Read all quantifiers of the previous atom
+					bool optional(false);
+					for(;;) {
+						if(*p == '{') {
+							p = std::strchr(p, '}');
+							if(unlikely(p == NULLPTR)) {
+								return;
+							}
+							optional = true;
+						} else if(*p != '+') {
+							optional = true;
+						}
+						if((p[1] != '*') && (p[1] != '?') && (p[1] != '{') && (p[1] != '+')) {
+							break;
+						}
+						++p;
+					}
+					if(optional && last_literal) {
+						curr.erase(curr.size() - 1);
+					}
+				}
+				exact = false;
+				break;
+			case '.':
+				exact = false;
+				break;
+			case '[':
+				exact = false;
+				p = skip_bracket(p);
+				if(unlikely(p == NULLPTR)) {
+					return;
+				}
+				break;
+			case '(':
+				exact = false;
+				p = skip_group(p);
+				if(unlikely(p == NULLPTR)) {
+					return;
+				}
+				break;
+			case '\\':
+				c = *(++p);
+				if(unlikely(c == '\0')) {
+					return;
+				}
+				// Only escaped special characters are literals:
+				// GNU regex gives e.g. \<, \>, \` and \' special meanings
+				literal = (std::strchr(".[]()*+?{}|^$\\", c) != NULLPTR);
+				if(!literal) {
+					exact = false;
+				}
+				break;
+			default:
+				literal = true;
+				break;
+		}
+		if(literal && (c >= ' ') && (c <= '~')) {
+			curr.append(1, (m_icase ? my_tolower(c) : c));
+			last_literal = true;
+			continue;
+		}
+		if(literal) {
+			exact = false;
+		}
+		end_run(&curr, &best);
+		last_literal = false;
+	}
+	end_run(&curr, &best);
+	if(best.empty()) {
+		return;
+	}
+	m_literal.swap(best);
+	if(!exact) {
+		m_literal_mode = LIT_FILTER;
+	} else if(anchor_begin) {
+		m_literal_mode = (anchor_end ? LIT_EQUAL : LIT_BEGIN);
+	} else {
+		m_literal_mode = (anchor_end ? LIT_END : LIT_CONTAINS);
+	}
+}
+
+bool Regex::literal_match(const char *s) const {
+	const string::size_type len(m_literal.size());
+	switch(m_literal_mode) {
+		case LIT_BEGIN:
+			return (m_icase ? casestarts(s, m_literal.c_str(), len) :
+				(std::strncmp(s, m_literal.c_str(), len) == 0));
+		case LIT_END:
+		case LIT_EQUAL: {
+				const string::size_type s_len(std::strlen(s));
+				if((s_len < len) ||
+					((m_literal_mode == LIT_EQUAL) && (s_len != len))) {
+					return false;
+				}
+				s += s_len - len;
+				return (m_icase ? casestarts(s, m_literal.c_str(), len) :
+					(std::memcmp(s, m_literal.c_str(), len) == 0));
+			}
+		// case LIT_FILTER:
+		// case LIT_CONTAINS:
+		default:
+			break;
+	}
+	return ((m_icase ? casefind(s, m_literal.c_str(), len) :
+		std::strstr(s, m_literal.c_str())) != NULLPTR);
 }
 
 /**
@@ -63,7 +281,20 @@ void Regex::compile(const char *regex, int eflags) {
 @return true if the regular expression matches
 **/
 bool Regex::match(const char *s) const {
-	return (!m_compiled) || (!regexec(get(), s, 0, NULLPTR, 0));
+	if(!m_compiled) {
+		return true;
+	}
+	if(m_literal_mode != LIT_NONE) {
+		if(!literal_match(s)) {
+			eix_assert_paranoic(regexec(get(), s, 0, NULLPTR, 0) != 0);
+			return false;
+		}
+		if(m_literal_mode != LIT_FILTER) {
+			eix_assert_paranoic(!regexec(get(), s, 0, NULLPTR, 0));
+			return true;
+		}
+	}
+	return !regexec(get(), s, 0, NULLPTR, 0);
 }
 
 /**
@@ -83,7 +314,8 @@ bool Regex::match(const char *s, string::size_type *b, string::size_type *e) con
 		}
 		return true;
 	}
-	if(regexec(get(), s, 1, pmatch, 0)) {
+	if(((m_literal_mode != LIT_NONE) && !literal_match(s)) ||
+		regexec(get(), s, 1, pmatch, 0)) {
 		if(likely(b != NULLPTR)) {
 			*b = string::npos;
 		}
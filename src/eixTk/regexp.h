@@ -38,20 +38,20 @@ class Regex {
 		/**
 		Initalize class
 		**/
-		Regex() : m_compiled(false) {
+		Regex() : m_compiled(false), m_literal_mode(LIT_NONE), m_icase(false) {
 		}
 
 		/**
 		Initalize and compile regular expression
 		**/
-		Regex(const char *regex, int eflags) : m_compiled(false) {
+		Regex(const char *regex, int eflags) : m_compiled(false), m_literal_mode(LIT_NONE), m_icase(false) {
 			compile(regex, eflags);
 		}
 
 		/**
 		Initalize and compile regular expression
 		**/
-		explicit Regex(const char *regex) : m_compiled(false) {
+		explicit Regex(const char *regex) : m_compiled(false), m_literal_mode(LIT_NONE), m_icase(false) {
 			compile(regex, REG_EXTENDED);
 		}
 
@@ -107,6 +107,38 @@ class Regex {
 		Is the regex already compiled and nonempty?
 		**/
 		bool m_compiled;
+
+		/**
+		How a match is related to m_literal:
+		LIT_FILTER: each match contains m_literal
+		LIT_CONTAINS, LIT_BEGIN, LIT_END, LIT_EQUAL: the regular expression
+		is equivalent to this relation, so regexec() is not needed
+		**/
+		enum LiteralMode {
+			LIT_NONE,
+			LIT_FILTER,
+			LIT_CONTAINS,
+			LIT_BEGIN,
+			LIT_END,
+			LIT_EQUAL
+		} m_literal_mode;
+
+		/**
+		The longest literal string (lowercase if m_icase) in the regex
+		**/
+		std::string m_literal;
+
+		bool m_icase;
+
+		/**
+		Set m_literal and m_literal_mode from the regular expression
+		**/
+		ATTRIBUTE_NONNULL_ void analyse(const char *regex);
+
+		/**
+		@return true if s has the relation m_literal_mode to m_literal
+		**/
+		ATTRIBUTE_NONNULL_ ATTRIBUTE_PURE bool literal_match(const char *s) const;
 };
 
 class RegexList {
@@ -49,7 +49,8 @@ StringHash *StringHash::comparison_this;
 locale localeC("C");
 
 ATTRIBUTE_NONNULL_ static void erase_escapes(string *s, const char *at);
-template<typename S, typename T> ATTRIBUTE_PURE ATTRIBUTE_NONNULL_ inline static S calc_table_pos(const vector<S>& table, S pos, const T *pattern, T c);
+ATTRIBUTE_CONST inline static char ascii_lower(char c);
+ATTRIBUTE_CONST inline static char ascii_upper(char c);
 template<typename T> ATTRIBUTE_NONNULL_ inline static void split_string_template(T *vec, const string& str, bool handle_escape, const char *at, bool ignore_empty);
 template<typename T> ATTRIBUTE_NONNULL_ inline static void join_to_string_template(string *s, const T& vec, const string& glue);
 
@@ -65,6 +66,40 @@ bool is_numeric(const char *str) {
 	return true;
 }
 
+/**
+@return pointer to the first character in [str, str_end) which is one of
+the first at_len characters of at, or str_end if there is none.
+**/
+const char *find_first_of_range(const char *str, const char *str_end, const char *at, size_t at_len) {
+#ifdef SUPPORT_SSE2
+	if(likely(at_len <= 8)) {
+		__m128i at16[8];
+		for(size_t i(0); i < at_len; ++i) {
+			at16[i] = _mm_set1_epi8(at[i]);
+		}
+		for(; likely(str_end - str >= 16); str += 16) {
+GCC_DIAG_OFF(cast-align)
+			const __m128i block(_mm_loadu_si128(reinterpret_cast<const __m128i *>(str)));
+GCC_DIAG_ON(cast-align)
+			__m128i found(_mm_setzero_si128());
+			for(size_t i(0); i < at_len; ++i) {
+				found = _mm_or_si128(found, _mm_cmpeq_epi8(block, at16[i]));
+			}
+			const int mask(_mm_movemask_epi8(found));
+			if(mask != 0) {
+				return str + __builtin_ctz(static_cast<unsigned int>(mask));
+			}
+		}
+	}
+#endif
+	for(; likely(str != str_end); ++str) {
+		if(std::memchr(at, *str, at_len) != NULLPTR) {
+			return str;
+		}
+	}
+	return str_end;
+}
+
 /**
 Add symbol if it is not already the last one
 **/
@@ -637,39 +672,82 @@ bool caseequal(const char *str, const char *pattern) {
 	return(*pattern == '\0');
 }
 
-/**
-Subroutine for Knuth-Morris-Pratt algorithm
-**/
-template<typename S, typename T> inline static S calc_table_pos(const vector<S>& table, S pos, const T *pattern, T c) {
-	while(pattern[pos] != c) {
-		if(pos == 0) {
-			return 0;
+inline static char ascii_lower(char c) {
+	return (((c >= 'A') && (c <= 'Z')) ? static_cast<char>(c - 'A' + 'a') : c);
+}
+
+inline static char ascii_upper(char c) {
+	return (((c >= 'a') && (c <= 'z')) ? static_cast<char>(c - 'a' + 'A') : c);
+}
+
+bool casestarts(const char *str, const char *pattern, size_t len) {
+	for(size_t i(0); likely(i < len); ++i) {
+		// This also stops at the end of str since pattern contains no '\0'
+		if(ascii_lower(str[i]) != pattern[i]) {
+			return false;
 		}
-		pos = table[pos];
 	}
-	return pos + 1;
+	return true;
+}
+
+const char *casefind(const char *str, const char *pattern, size_t len) {
+	if(unlikely(len == 0)) {
+		return str;
+	}
+#ifdef SUPPORT_SSE2
+	// Test first and last character of pattern at 16 positions at once
+	const size_t str_len(std::strlen(str));
+	if(str_len < len) {
+		return NULLPTR;
+	}
+	const size_t last(len - 1);
+	const size_t middle((len > 2) ? (len - 2) : 0);
+	const __m128i first_lower(_mm_set1_epi8(pattern[0]));
+	const __m128i first_upper(_mm_set1_epi8(ascii_upper(pattern[0])));
+	const __m128i last_lower(_mm_set1_epi8(pattern[last]));
+	const __m128i last_upper(_mm_set1_epi8(ascii_upper(pattern[last])));
+	size_t i(0);
+	for(; likely(i + last + 16 <= str_len); i += 16) {
+GCC_DIAG_OFF(cast-align)
+		const __m128i block_first(_mm_loadu_si128(reinterpret_cast<const __m128i *>(str + i)));
+		const __m128i block_last(_mm_loadu_si128(reinterpret_cast<const __m128i *>(str + i + last)));
+GCC_DIAG_ON(cast-align)
+		unsigned int mask(static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(block_first, first_lower),
+				_mm_cmpeq_epi8(block_first, first_upper)),
+			_mm_or_si128(_mm_cmpeq_epi8(block_last, last_lower),
+				_mm_cmpeq_epi8(block_last, last_upper))))));
+		while(mask != 0) {
+			const char *candidate(str + i + static_cast<size_t>(__builtin_ctz(mask)));
+			if(casestarts(candidate + 1, pattern + 1, middle)) {
+				return candidate;
+			}
+			mask &= mask - 1;
+		}
+	}
+	for(; i + last < str_len; ++i) {
+		if(casestarts(str + i, pattern, len)) {
+			return str + i;
+		}
+	}
+	return NULLPTR;
+#else
+	const char first[3] = { pattern[0], ascii_upper(pattern[0]), '\0' };
+	for(str = std::strpbrk(str, first); str != NULLPTR;
+		str = std::strpbrk(str + 1, first)) {
+		if(casestarts(str + 1, pattern + 1, len - 1)) {
+			return str;
+		}
+	}
+	return NULLPTR;
+#endif
 }
 
 /**
 Check whether str contains a nonempty lowercase pattern case-insensitively
 **/
 bool casecontains(const char *str, const char *pattern) {
-	// Knuth-Morris-Pratt algorithm
-	typedef string::size_type IndexType;
-	IndexType l(std::strlen(pattern));
-	vector<IndexType> table(l, 0);
-	IndexType pos(0);
-	for(IndexType i(1); likely(i < l); ++i) {
-		pos = table[i] = calc_table_pos(table, pos, pattern, pattern[i]);
-	}
-	pos = 0;
-	for(char c(*str); likely(c != '\0'); c = *(++str)) {
-		pos = calc_table_pos(table, pos, pattern, my_tolower(c));
-		if(pos == l) {
-			return true;
-		}
-	}
-	return false;
+	return (casefind(str, pattern, std::strlen(pattern)) != NULLPTR);
 }
 
 string::size_type utf8size(const string &t, string::size_type begin, string::size_type end) {
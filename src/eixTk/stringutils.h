@@ -118,6 +118,13 @@ const char *first_alnum(const char *s);
 **/
 const char *first_not_alnum_or_ok(const char *s, const char *ok);
 
+/**
+@return pointer to the first character in [str, str_end) which is one of
+the first at_len characters of at, or str_end if there is none.
+With sse2, 16 characters are checked at once if at_len <= 8.
+**/
+ATTRIBUTE_NONNULL_ ATTRIBUTE_PURE const char *find_first_of_range(const char *str, const char *str_end, const char *at, size_t at_len);
+
 /**
 Add symbol if it is not already the last one
 **/
@@ -399,7 +406,7 @@ inline static bool caseequal(const std::string& str, const char *pattern) {
 /**
 Check whether str contains a nonempty lowercase pattern case-insensitively
 **/
-ATTRIBUTE_NONNULL_ bool casecontains(const char *str, const char *pattern);
+ATTRIBUTE_NONNULL_ ATTRIBUTE_PURE bool casecontains(const char *str, const char *pattern);
 
 /**
 Check whether str contains a nonempty lowercase pattern case-insensitively
@@ -409,6 +416,19 @@ inline static bool casecontains(const std::string& str, const char *pattern) {
 	return casecontains(str.c_str(), pattern);
 }
 
+/**
+Check whether str starts with the lowercase pattern of length len
+case-insensitively (only ASCII letters are folded)
+**/
+ATTRIBUTE_NONNULL_ ATTRIBUTE_PURE bool casestarts(const char *str, const char *pattern, size_t len);
+
+/**
+@return the first occurrence in str of the lowercase pattern of length len
+case-insensitively (only ASCII letters are folded), or NULLPTR.
+With sse2, 16 positions are checked at once.
+**/
+ATTRIBUTE_NONNULL_ ATTRIBUTE_PURE const char *casefind(const char *str, const char *pattern, size_t len);
+
 /**
 Check whether char is utf8 first-byte
 **/
@@ -15,6 +15,7 @@
 // unistd.h is needed on Solaris for including stropts.h, see below
 // check_includes: _exit
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -115,6 +116,23 @@ bool is_pure_file(const char *file) {
 	return S_ISREG(stat_buf.st_mode);
 }
 
+/**
+Tell the kernel that file will be read soon
+**/
+#ifdef HAVE_POSIX_FADVISE
+void prefetch_file(const char *file) {
+	int fd(open(file, O_RDONLY));
+	if(unlikely(fd < 0)) {
+		return;
+	}
+	posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+	close(fd);
+}
+#else
+void prefetch_file(const char * /* file */) {
+}
+#endif
+
 /**
 @return mtime of file.
 **/
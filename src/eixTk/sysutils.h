@@ -49,6 +49,12 @@ ATTRIBUTE_NONNULL_ bool is_file(const char *file);
 **/
 ATTRIBUTE_NONNULL_ bool is_pure_file(const char *file);
 
+/**
+Tell the kernel that file will be read soon, so that reading can start
+in the background. This is only a hint: Errors are silently ignored.
+**/
+ATTRIBUTE_NONNULL_ void prefetch_file(const char *file);
+
 /**
 @return true if mtime of file can be read
 **/
@@ -14,6 +14,9 @@
 #endif
 
 #include <dirent.h>
+#ifdef HAVE_FSTATAT
+#include <fcntl.h>
+#endif
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -41,19 +44,37 @@ using std::string;
 class Directory {
 	private:
 		DIR *dh;
+#if !defined(HAVE_DIRFD) || !defined(HAVE_FSTATAT)
+		string path;
+#endif
 
 	public:
 		Directory() : dh(NULLPTR) {
 		}
 
-		bool opendirectory(const char *name) {
-			return ((dh = opendir(name)) != NULLPTR);
+		bool opendirectory(const string& name) {
+#if !defined(HAVE_DIRFD) || !defined(HAVE_FSTATAT)
+			path = name;
+			optional_append(&path, '/');
+#endif
+			return ((dh = opendir(name.c_str())) != NULLPTR);
 		}
 
 		struct dirent *read() {
 			return readdir(dh);  // NOLINT(runtime/threadsafe_fn)
 		}
 
+		/**
+		stat() an entry of the directory (following symbolic links)
+		**/
+		ATTRIBUTE_NONNULL_ bool stat_entry(const char *name, struct stat *st) const {
+#if defined(HAVE_DIRFD) && defined(HAVE_FSTATAT)
+			return (fstatat(dirfd(dh), name, st, 0) == 0);
+#else
+			return (stat((path + name).c_str(), st) == 0);
+#endif
+		}
+
 		~Directory() {
 			if(dh != NULLPTR) {
 				closedir(dh);
@@ -61,22 +82,123 @@ class Directory {
 		}
 };
 
-ATTRIBUTE_NONNULL((1, 2)) static bool pushback_lines_file(const char *file, WordVec *v, bool keep_empty, eix::SignedBool keep_comments, string *errtext);
-static int pushback_files_selector(SCANDIR_ARG3 dir_entry);
+/**
+Selector which calls a scandir-like callback function
+**/
+class CallbackSelector {
+	private:
+		select_dirent select;
+
+	public:
+		explicit CallbackSelector(select_dirent s) : select(s) {
+		}
+
+		bool operator()(const struct dirent *d) const {
+			return ((select == NULLPTR) || ((*select)(d) != 0));
+		}
+};
+
+/**
+Selector for pushback_files(): Exclude hidden names or names from a list
+**/
+class ExcludeSelector {
+	private:
+		const char *const *exclude;
+		bool no_hidden;
+
+	public:
+		ExcludeSelector(const char *const *e, bool n) : exclude(e), no_hidden(n) {
+		}
 
-bool scandir_cc(const string& dir, WordVec *namelist, select_dirent select, bool sorted) {
+		ATTRIBUTE_NONNULL_ ATTRIBUTE_PURE bool operator()(const struct dirent *d) const;
+};
+
+bool ExcludeSelector::operator()(const struct dirent *d) const {
+	const char *name(d->d_name);
+	// Empty names shouldn't occur. Just to be sure, we ignore them:
+	if(unlikely(name[0] == '\0')) {
+		return false;
+	}
+	if(likely(no_hidden)) {
+		// files starting with '.' are hidden.
+		if(name[0] == '.') {
+			return false;
+		}
+		// files ending with '~' are hidden.
+		// (Note that we already excluded the bad case of empty names).
+		if(name[std::strlen(name) - 1] == '~') {
+			return false;
+		}
+	}
+	if(exclude != NULLPTR) {
+		// Look if it's in exclude
+		for(const char *const *p(exclude); likely(*p != NULLPTR); ++p) {
+			if(unlikely(std::strcmp(*p, name) == 0)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+@return true if the type of the entry is accepted by only_type.
+d_type is used if available; only symbolic links and unknown types
+(e.g. on filesystems without d_type support) require a stat()
+**/
+ATTRIBUTE_NONNULL_ static bool dirent_type_ok(const Directory& dir, const struct dirent *d, unsigned char only_type) {
+#ifdef HAVE_STRUCT_DIRENT_D_TYPE
+	switch(d->d_type) {
+		case DT_REG:
+			return ((only_type & 1) != 0);
+		case DT_DIR:
+			return ((only_type & 2) != 0);
+		case DT_LNK:
+		case DT_UNKNOWN:
+			break;
+		default:
+			return false;
+	}
+#endif
+	struct stat st;
+	if(unlikely(!dir.stat_entry(d->d_name, &st))) {
+		return false;
+	}
+	if(S_ISREG(st.st_mode)) {
+		return ((only_type & 1) != 0);
+	}
+	if(S_ISDIR(st.st_mode)) {
+		return ((only_type & 2) != 0);
+	}
+	return false;
+}
+
+/**
+Read the names of a directory which are accepted by select and only_type.
+@param only_type: see scandir_cc
+**/
+template<class Selector> ATTRIBUTE_NONNULL_ static bool scan_directory(const string& dir, WordVec *namelist, const Selector& select, unsigned char only_type, bool sorted);
+template<class Selector> static bool scan_directory(const string& dir, WordVec *namelist, const Selector& select, unsigned char only_type, bool sorted) {
 	namelist->clear(); {
 		Directory my_dir;
-		if(!my_dir.opendirectory(dir.c_str())) {
+		if(!my_dir.opendirectory(dir)) {
 			return false;
 		}
 		struct dirent *d;
 		while(likely((d = my_dir.read()) != NULLPTR)) {
 			const char *name(d->d_name);
 			// Omit "." and ".." since we must not rely on their existence anyway
-			if(likely(std::strcmp(name, ".") && std::strcmp(name, "..") && (*select)(d))) {
-				namelist->PUSH_BACK(MOVE(name));
+			if(unlikely((name[0] == '.') && ((name[1] == '\0') ||
+				((name[1] == '.') && (name[2] == '\0'))))) {
+				continue;
 			}
+			if(!select(d)) {
+				continue;
+			}
+			if((only_type != 0) && !dirent_type_ok(my_dir, d, only_type)) {
+				continue;
+			}
+			namelist->PUSH_BACK(name);
 		}
 	}
 	if(sorted) {
@@ -85,6 +207,12 @@ bool scandir_cc(const string& dir, WordVec *namelist, select_dirent select, bool
 	return true;
 }
 
+ATTRIBUTE_NONNULL((1, 2)) static bool pushback_lines_file(const char *file, WordVec *v, bool keep_empty, eix::SignedBool keep_comments, string *errtext);
+
+bool scandir_cc(const string& dir, WordVec *namelist, select_dirent select, unsigned char only_type, bool sorted) {
+	return scan_directory(dir, namelist, CallbackSelector(select), only_type, sorted);
+}
+
 /**
 push_back every line of file into v.
 **/
@@ -161,60 +289,6 @@ bool pushback_lines(const char *file, LineVec *v, bool recursive, bool keep_empt
 	}
 }
 
-/**
-These variables and function are only supposed to be used from
-pushback_files. We cannot use a class here, because scandir wants a
-"blank" selector-function
-**/
-static const char *const *pushback_files_exclude;
-static bool pushback_files_no_hidden;
-static size_t pushback_files_only_type;
-static const string *pushback_files_dir_path;  // defined if pushback_files_only_type is nonzero
-static int pushback_files_selector(SCANDIR_ARG3 dir_entry) {
-	// Empty names shouldn't occur. Just to be sure, we ignore them:
-	if(!((dir_entry->d_name)[0])) {
-		return 0;
-	}
-
-	if(likely(pushback_files_no_hidden)) {
-		// files starting with '.' are hidden.
-		if((dir_entry->d_name)[0] == '.') {
-			return 0;
-		}
-		// files ending with '~' are hidden.
-		// (Note that we already excluded the bad case of empty names).
-		if((dir_entry->d_name)[std::strlen(dir_entry->d_name) - 1] == '~') {
-			return 0;
-		}
-	}
-	if(pushback_files_exclude) {
-		// Look if it's in exclude
-		for(const char *const *p(pushback_files_exclude); likely(*p != NULLPTR); ++p) {
-			if(unlikely(std::strcmp(*p, dir_entry->d_name) == 0)) {
-				return 0;
-			}
-		}
-	}
-	if(likely(pushback_files_only_type == 0)) {
-		return 1;
-	}
-	struct stat static_stat;
-	if(unlikely(stat(((*pushback_files_dir_path) + dir_entry->d_name).c_str(), &static_stat))) {
-		return 0;
-	}
-	if(pushback_files_only_type & 1) {
-		if(S_ISREG(static_stat.st_mode)) {
-			return 1;
-		}
-	}
-	if(pushback_files_only_type & 2) {
-		if(S_ISDIR(static_stat.st_mode)) {
-			return 1;
-		}
-	}
-	return 0;
-}
-
 /**
 List of files in directory.
 Pushed names of file in directory into string-vector if the don't match any
@@ -228,14 +302,8 @@ char * in given exlude list.
 @return true if everything is ok
 **/
 bool pushback_files(const string& dir_path, WordVec *into, const char *const exclude[], unsigned char only_type, bool no_hidden, bool full_path) {
-	pushback_files_exclude = exclude;
-	pushback_files_no_hidden = no_hidden;
-	pushback_files_only_type = only_type;
-	if(only_type) {
-		pushback_files_dir_path = &dir_path;
-	}
 	WordVec namelist;
-	if(!scandir_cc(dir_path, &namelist, pushback_files_selector)) {
+	if(!scan_directory(dir_path, &namelist, ExcludeSelector(exclude, no_hidden), only_type, true)) {
 		return false;
 	}
 	for(WordVec::iterator it(namelist.begin());
@@ -25,14 +25,23 @@ We keep the original type for the callback function
 (including possible case distinctions whether its argument is const)
 for the case that we *have* to use scandir() for the implementation
 on some systems (which however is rather unlikely)
+The callback may be NULLPTR to accept all names.
+@param only_type: if 1: consider only ordinary files, if 2: consider only dirs, if 3: consider only files or dirs
+The type is taken from d_type if the system provides it; stat() is only
+used for symbolic links or if the filesystem does not report the type.
+No global state is used, so this is reentrant.
 **/
 struct dirent;
 #define SCANDIR_ARG3 const struct dirent *
 typedef int (*select_dirent)(SCANDIR_ARG3 dir_entry);
-ATTRIBUTE_NONNULL_ bool scandir_cc(const std::string& dir, WordVec *namelist, select_dirent select, bool sorted);
-ATTRIBUTE_NONNULL_ inline static bool scandir_cc(const std::string& dir, WordVec *namelist, select_dirent select);
+ATTRIBUTE_NONNULL((2)) bool scandir_cc(const std::string& dir, WordVec *namelist, select_dirent select, unsigned char only_type, bool sorted);
+ATTRIBUTE_NONNULL((2)) inline static bool scandir_cc(const std::string& dir, WordVec *namelist, select_dirent select, bool sorted);
+inline static bool scandir_cc(const std::string& dir, WordVec *namelist, select_dirent select, bool sorted) {
+	return scandir_cc(dir, namelist, select, 0, sorted);
+}
+ATTRIBUTE_NONNULL((2)) inline static bool scandir_cc(const std::string& dir, WordVec *namelist, select_dirent select);
 inline static bool scandir_cc(const std::string& dir, WordVec *namelist, select_dirent select) {
-	return scandir_cc(dir, namelist, select, true);
+	return scandir_cc(dir, namelist, select, 0, true);
 }
 
 /**
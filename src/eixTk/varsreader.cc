@@ -101,6 +101,15 @@ Check value-buffer for overrun and push c into the current value-buffer
 		value.append(&(c), 1); \
 	} while(0)
 
+/**
+Push the characters up to (excluding) end into the current value-buffer
+and move to end
+**/
+#define VALUE_APPEND_UNTIL(end) do { \
+		value.append(x, static_cast<string::size_type>((end) - (x))); \
+		x = (end); \
+	} while(0)
+
 /**
 Reset value pointer
 **/
@@ -136,7 +145,10 @@ Read until '\n' '#' '\\' '\'' '"'
 '\n' -> [RV] (and check if we are at EOF, EOF's only occur after a newline) -> JUMP_WHITESPACE
 **/
 void VarsReader::JUMP_NOISE() {
-	while(likely(INPUT != '#' && INPUT != '\n' && INPUT != '\'' && INPUT != '"' && INPUT != '\\')) NEXT_INPUT;
+	x = find_first_of_range(x, filebuffer_end, "#\n'\"\\", 5);
+	if(INPUT_EOF) {
+		STOP;
+	}
 	switch(INPUT) {
 		case '#':   NEXT_INPUT;
 		            CHSTATE(JUMP_COMMENT);
@@ -195,8 +207,10 @@ Jump comments.
 Read until the next '\n' comes in. Then move to JUMP_NOISE.
 **/
 void VarsReader::JUMP_COMMENT() {
-	while(likely(INPUT != '\n')) {
-		NEXT_INPUT;
+	x = static_cast<const char *>(std::memchr(x, '\n',
+		static_cast<size_t>(filebuffer_end - x)));
+	if(unlikely(x == NULLPTR)) {
+		STOP;
 	}
 	CHSTATE(JUMP_NOISE);
 }
@@ -437,9 +451,9 @@ If the value ends, EVAL_READ is called.
 '\\' -> [RV] SINGLE_QUOTE_ESCAPE | '\'' -> [RV] EVAL_READ
 **/
 void VarsReader::VALUE_SINGLE_QUOTE() {
-	while(likely((INPUT != '\'') && (INPUT != '\\'))) {
-		VALUE_APPEND(INPUT);
-		NEXT_INPUT_EVAL;
+	VALUE_APPEND_UNTIL(find_first_of_range(x, filebuffer_end, "'\\", 2));
+	if(INPUT_EOF) {
+		CHSTATE(EVAL_READ);
 	}
 	switch(INPUT) {
 		case '\'':  NEXT_INPUT_EVAL;
@@ -455,28 +469,43 @@ Copy INPUT into value-buffer while INPUT is not in ['\\].
 If the value ends, EVAL_READ is called.
 '\\' -> [RV] SINGLE_QUOTE_ESCAPE_PORTAGE | '\'' -> [RV] EVAL_READ
 **/
-void VarsReader::VALUE_SINGLE_QUOTE_PORTAGE() {
-	while(likely((INPUT != '\'') && (INPUT != '\\'))) {
-		if(unlikely((INPUT == '$') && ((parse_flags & SUBST_VARS) != NONE))) {
+size_t VarsReader::portage_stop_len() const {
+	if((parse_flags & SUBST_VARS) == NONE) {
+		return 3;
+	}
+	return (((parse_flags & PORTAGE_SECTIONS) != NONE) ? 5 : 4);
+}
+
+bool VarsReader::portage_special() {
+	switch(INPUT) {
+		case '\n':
+			VALUE_APPEND(ESC_SP);
+			++x;
+			return true;
+		case '$':
 			resolveReference();
-			if(INPUT_EOF) {
-				CHSTATE(EVAL_READ);
-			}
-			continue;
-		}
-		if(unlikely((INPUT == '%') && ((parse_flags & (SUBST_VARS|PORTAGE_SECTIONS)) == (SUBST_VARS|PORTAGE_SECTIONS)))) {
+			return true;
+		case '%':
 			resolveSectionReference();
-			if(INPUT_EOF) {
-				CHSTATE(EVAL_READ);
-			}
-			continue;
+			return true;
+		default:
+			return false;
+	}
+}
+
+void VarsReader::VALUE_SINGLE_QUOTE_PORTAGE() {
+	const size_t stop_len(portage_stop_len());
+	for(;;) {
+		VALUE_APPEND_UNTIL(find_first_of_range(x, filebuffer_end, "'\\\n$%", stop_len));
+		if(INPUT_EOF) {
+			CHSTATE(EVAL_READ);
 		}
-		if(unlikely(INPUT == '\n')) {
-			VALUE_APPEND(ESC_SP);
-		} else {
-			VALUE_APPEND(INPUT);
+		if(!portage_special()) {
+			break;
+		}
+		if(INPUT_EOF) {
+			CHSTATE(EVAL_READ);
 		}
-		NEXT_INPUT_EVAL;
 	}
 	switch(INPUT) {
 		case '\'':
@@ -495,16 +524,19 @@ If the value ends, EVAL_READ is called.
 '\\' -> [RV] DOUBLE_QUOTE_ESCAPE | '"' -> [RV] EVAL_READ
 **/
 void VarsReader::VALUE_DOUBLE_QUOTE() {
-	while(likely(INPUT != '"' && INPUT != '\\')) {
-		if(unlikely(INPUT == '$' && ((parse_flags & SUBST_VARS) != NONE))) {
-			resolveReference();
-			if(INPUT_EOF) {
-				CHSTATE(EVAL_READ);
-			}
-			continue;
+	const size_t stop_len(((parse_flags & SUBST_VARS) != NONE) ? 3 : 2);
+	for(;;) {
+		VALUE_APPEND_UNTIL(find_first_of_range(x, filebuffer_end, "\"\\$", stop_len));
+		if(INPUT_EOF) {
+			CHSTATE(EVAL_READ);
+		}
+		if(INPUT != '$') {
+			break;
+		}
+		resolveReference();
+		if(INPUT_EOF) {
+			CHSTATE(EVAL_READ);
 		}
-		VALUE_APPEND(INPUT);
-		NEXT_INPUT_EVAL;
 	}
 	switch(INPUT) {
 		case '"':  NEXT_INPUT_EVAL;
@@ -521,27 +553,18 @@ If the value ends, EVAL_READ is called.
 '\\' -> [RV] DOUBLE_QUOTE_ESCAPE_PORTAGE | '"' -> [RV] EVAL_READ
 **/
 void VarsReader::VALUE_DOUBLE_QUOTE_PORTAGE() {
-	while(likely(INPUT != '"' && INPUT != '\\')) {
-		if(unlikely((INPUT == '$') && ((parse_flags & SUBST_VARS) != NONE))) {
-			resolveReference();
-			if(INPUT_EOF) {
-				CHSTATE(EVAL_READ);
-			}
-			continue;
+	const size_t stop_len(portage_stop_len());
+	for(;;) {
+		VALUE_APPEND_UNTIL(find_first_of_range(x, filebuffer_end, "\"\\\n$%", stop_len));
+		if(INPUT_EOF) {
+			CHSTATE(EVAL_READ);
 		}
-		if(unlikely((INPUT == '%') && ((parse_flags & (SUBST_VARS|PORTAGE_SECTIONS)) == (SUBST_VARS|PORTAGE_SECTIONS)))) {
-			resolveSectionReference();
-			if(INPUT_EOF) {
-				CHSTATE(EVAL_READ);
-			}
-			continue;
+		if(!portage_special()) {
+			break;
 		}
-		if(unlikely(INPUT == '\n')) {
-			VALUE_APPEND(ESC_SP);
-		} else {
-			VALUE_APPEND(INPUT);
+		if(INPUT_EOF) {
+			CHSTATE(EVAL_READ);
 		}
-		NEXT_INPUT_EVAL;
 	}
 	switch(INPUT) {
 		case '"':
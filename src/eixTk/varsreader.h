@@ -354,6 +354,19 @@ class VarsReader {
 		**/
 		void resolveSectionReference();
 
+		/**
+		@return the number of leading characters of "Q\\\n$%" (Q the quote)
+		which need special treatment in the _PORTAGE quote states
+		**/
+		ATTRIBUTE_PURE size_t portage_stop_len() const;
+
+		/**
+		Treat the special characters '\n', '$', and '%' of the _PORTAGE
+		quote states. INPUT_EOF might be true at stop.
+		@return false if INPUT is not one of these characters
+		**/
+		bool portage_special();
+
 		/**
 		Read file using a new instance of VarsReader with the same
 		settings (except for APPEND_VALUES),
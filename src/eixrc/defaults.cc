@@ -283,6 +283,11 @@ AddOption(INTEGER, "EIX_LIMIT_COMPACT",
 	"The maximal number of matches shown on terminal in compact mode.\n"
 	"The value 0 means all matches are shown."));
 
+AddOption(INTEGER, "MATCH_LIMIT",
+	"0", P_("MATCH_LIMIT",
+	"The default for --limit: eix stops after this number of matches.\n"
+	"The value 0 means there is no limit."));
+
 AddOption(BOOLEAN, "QUICKMODE",
 	"false", P_("QUICKMODE",
 	"Whether --quick is on by default."));
@@ -459,6 +464,11 @@ AddOption(BOOLEAN, "UPDATE_VERBOSE",
 	"false", P_("UPDATE_VERBOSE",
 	"Whether eix-update -v is on by default (output cache method per ebuild)"));
 
+AddOption(BOOLEAN, "UPDATE_PREFETCH",
+	"true", P_("UPDATE_PREFETCH",
+	"If true, eix-update asks the kernel to read ahead all metadata cache files\n"
+	"of a category before parsing them. This speeds up reading from cold caches."));
+
 AddOption(STRING, "CACHE_METHOD_PARSE",
 	"#metadata-md5#metadata-flat#assign", P_("CACHE_METHOD_PARSE",
 	"This string is appended to all cache methods using parse[*] or ebuild[*]."));
@@ -139,15 +139,20 @@ LocalMode EixRc::getLocalMode(const string& key) {
 	return LOCALMODE_DEFAULT;
 }
 
-const char *EixRc::cstr(const string& key) const {
+const char *EixRc::cstr(const string& key) {
 	WordUnorderedMap::const_iterator s(main_map.find(key));
 	if(s == main_map.end()) {
 		return NULLPTR;
 	}
-	return (s->second).c_str();
+	// s might become invalid by resolve_delayed, but the reference not
+	const string& value(s->second);
+	if(unlikely(has_delayed.count(key) != 0)) {
+		resolve_delayed(key);
+	}
+	return value.c_str();
 }
 
-const char *EixRc::prefix_cstr(const string& key) const {
+const char *EixRc::prefix_cstr(const string& key) {
 	const char *s(cstr(key));
 	if(unlikely(s == NULLPTR)) {
 		return NULLPTR;
@@ -177,15 +182,10 @@ void EixRc::read() {
 	}
 	modify_value(&m_eprefixconf, name);
 
-	WordUnorderedSet has_delayed;
-
 	// First, we create defaults and main_map with all variables
 	// (including all values required by delayed references).
-	read_undelayed(&has_delayed);
-
-	// Resolve delayed references recursively.
-	for(default_index i(0); i < defaults.size(); ++i)
-		resolve_delayed(defaults[i].key, &has_delayed);
+	// The delayed references are resolved only when a variable is used.
+	read_undelayed();
 
 	// set m_eprefixconf to possibly new settings:
 	m_eprefixconf = (*this)["PORTAGE_CONFIGROOT"];
@@ -194,7 +194,12 @@ void EixRc::read() {
 const string& EixRc::operator[](const string& key) {
 	WordUnorderedMap::const_iterator it(main_map.find(key));
 	if(it != main_map.end()) {
-		return it->second;
+		// it might become invalid by resolve_delayed, but the reference not
+		const string& value(it->second);
+		if(unlikely(has_delayed.count(key) != 0)) {
+			resolve_delayed(key);
+		}
+		return value;
 	}
 	add_later_variable(key);
 	return main_map[key];
@@ -208,16 +213,15 @@ Of course, it will be resolved for delayed substitutions,
 and delayed references are also be added similarly.
 **/
 void EixRc::add_later_variable(const string& key) {
-	WordUnorderedSet has_delayed;
-	join_key(key, &has_delayed, true, NULLPTR);
-	resolve_delayed(key, &has_delayed);
+	join_key(key, true, NULLPTR);
+	resolve_delayed(key);
 }
 
-void EixRc::resolve_delayed(const string& key, WordUnorderedSet *has_delayed) {
+void EixRc::resolve_delayed(const string& key) {
 	WordUnorderedSet visited;
 	const char *errtext;
 	string errvar;
-	if(unlikely(resolve_delayed_recurse(key, &visited, has_delayed,
+	if(unlikely(resolve_delayed_recurse(key, &visited,
 		&errtext, &errvar) == NULLPTR)) {
 		eix::say_error(_(
 			"fatal config error: %s in delayed substitution of %s"))
@@ -226,9 +230,9 @@ void EixRc::resolve_delayed(const string& key, WordUnorderedSet *has_delayed) {
 	}
 }
 
-string *EixRc::resolve_delayed_recurse(const string& key, WordUnorderedSet *visited, WordUnorderedSet *has_delayed, const char **errtext, string *errvar) {
+string *EixRc::resolve_delayed_recurse(const string& key, WordUnorderedSet *visited, const char **errtext, string *errvar) {
 	string *value(&(main_map[key]));
-	if(has_delayed->count(key) == 0) {
+	if(has_delayed.count(key) == 0) {
 		modify_value(value, key);
 		return value;
 	}
@@ -241,7 +245,7 @@ string *EixRc::resolve_delayed_recurse(const string& key, WordUnorderedSet *visi
 		bool will_test(false);
 		switch(type) {
 			case DelayedNotFound:
-				has_delayed->erase(key);
+				has_delayed.erase(key);
 				modify_value(value, key);
 				return value;
 			case DelayedFi:
@@ -274,7 +278,7 @@ string *EixRc::resolve_delayed_recurse(const string& key, WordUnorderedSet *visi
 		const string *s(resolve_delayed_recurse(
 			(((varflags & DELAYVAR_STAR) != DELAYVAR_NONE) ?
 				(varprefix + varname) : varname),
-			visited, has_delayed, errtext, errvar));
+			visited, errtext, errvar));
 		visited->erase(key);
 		if(unlikely(s == NULLPTR)) {
 			return NULLPTR;
@@ -388,9 +392,9 @@ static void override_by_env(WordIterateMap *m) {
 /**
 Create defaults and the main_map with all variables
 (including all values required by delayed references).
-@arg has_delayed is initialized to corresponding keys
+has_delayed is initialized to corresponding keys
 **/
-void EixRc::read_undelayed(WordUnorderedSet *has_delayed) {
+void EixRc::read_undelayed() {
 	// Initialize with the default variables
 	for(default_index i(0); likely(i < defaults.size()); ++i)
 		filevarmap[defaults[i].key] = defaults[i].value;
@@ -464,7 +468,7 @@ void EixRc::read_undelayed(WordUnorderedSet *has_delayed) {
 	}
 	for(vector<EixRcOption>::iterator it(defaults.begin());
 		likely(it != defaults.end()); ++it) {
-		join_key(it->key, has_delayed, false, &original_defaults);
+		join_key(it->key, false, &original_defaults);
 	}
 }
 
@@ -472,7 +476,7 @@ void EixRc::read_undelayed(WordUnorderedSet *has_delayed) {
 Recursively eval and join key and its delayed references to
 main_map and default; set has_delayed if appropriate
 **/
-void EixRc::join_key(const string& key, WordUnorderedSet *has_delayed, bool add_top_to_defaults, const WordUnorderedSet *exclude_defaults) {
+void EixRc::join_key(const string& key, bool add_top_to_defaults, const WordUnorderedSet *exclude_defaults) {
 	string *val(&main_map[key]);
 	WordIterateMap::const_iterator f(filevarmap.find(key));
 	if(unlikely(f != filevarmap.end())) {
@@ -499,10 +503,10 @@ void EixRc::join_key(const string& key, WordUnorderedSet *has_delayed, bool add_
 			defaults.EMPLACE_BACK(EixRcOption, (key, *val));
 		}
 	}
-	join_key_rec(key, *val, has_delayed, exclude_defaults);
+	join_key_rec(key, *val, exclude_defaults);
 }
 
-void EixRc::join_key_rec(const string& key, const string& val, WordUnorderedSet *has_delayed, const WordUnorderedSet *exclude_defaults) {
+void EixRc::join_key_rec(const string& key, const string& val, const WordUnorderedSet *exclude_defaults) {
 	string::size_type pos(0);
 	string::size_type length;
 	for(;; pos += length) {
@@ -516,10 +520,10 @@ void EixRc::join_key_rec(const string& key, const string& val, WordUnorderedSet
 			case DelayedIfFalse:
 				break;
 			default:
-				has_delayed->INSERT(key);
+				has_delayed.INSERT(key);
 				continue;
 		}
-		has_delayed->INSERT(key);
+		has_delayed.INSERT(key);
 		if(unlikely((varflags & DELAYVAR_STAR) != DELAYVAR_NONE)) {
 			static CONSTEXPR const char *prefixlist[] = {
 				EIX_VARS_PREFIX,
@@ -531,17 +535,17 @@ void EixRc::join_key_rec(const string& key, const string& val, WordUnorderedSet
 			for(const char *const *prefix = prefixlist;
 				*prefix != NULLPTR; ++prefix) {
 				join_key_if_new(string(*prefix) + varname,
-					has_delayed, exclude_defaults);
+					exclude_defaults);
 			}
 		} else {
-			join_key_if_new(varname, has_delayed, exclude_defaults);
+			join_key_if_new(varname, exclude_defaults);
 		}
 	}
 }
 
-void EixRc::join_key_if_new(const string& key, WordUnorderedSet *has_delayed, const WordUnorderedSet *exclude_defaults) {
+void EixRc::join_key_if_new(const string& key, const WordUnorderedSet *exclude_defaults) {
 	if(unlikely(main_map.count(key) == 0)) {
-		join_key(key, has_delayed, true, exclude_defaults);
+		join_key(key, true, exclude_defaults);
 	}
 }
 
@@ -682,6 +686,7 @@ void EixRc::clear() {
 	prefix_keys.clear();
 	filevarmap.clear();
 	main_map.clear();
+	has_delayed.clear();
 }
 
 void EixRc::addDefault(EixRcOption option) {
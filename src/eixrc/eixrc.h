@@ -84,9 +84,9 @@ class EixRc {
 
 		ATTRIBUTE_NONNULL_ void dumpDefaults(FILE *s, bool use_defaults);
 
-		ATTRIBUTE_PURE const char *cstr(const std::string& key) const;
+		const char *cstr(const std::string& key);
 
-		ATTRIBUTE_PURE const char *prefix_cstr(const std::string& key) const;
+		const char *prefix_cstr(const std::string& key);
 
 		void known_vars();
 		bool print_var(const std::string& key);
@@ -102,6 +102,11 @@ class EixRc {
 		std::vector<EixRcOption> defaults;
 		WordUnorderedSet prefix_keys;
 
+		/**
+		The variables whose delayed references are not resolved yet
+		**/
+		WordUnorderedSet has_delayed;
+
 		enum DelayedType { DelayedNotFound, DelayedVariable, DelayedIfTrue, DelayedIfFalse, DelayedIfNonempty, DelayedIfEmpty, DelayedElse, DelayedFi, DelayedQuote };
 
 		ATTRIBUTE_NONNULL((3)) static bool getRedundantFlagAtom(const char *s, Keywords::Redundant type, RedAtom *r);
@@ -117,22 +122,22 @@ class EixRc {
 		**/
 		void add_later_variable(const std::string& key);
 
-		ATTRIBUTE_NONNULL_ void resolve_delayed(const std::string& key, WordUnorderedSet *has_delayed);
-		ATTRIBUTE_NONNULL_ std::string *resolve_delayed_recurse(const std::string& key, WordUnorderedSet *visited, WordUnorderedSet *has_delayed, const char **errtext, std::string *errvar);
+		void resolve_delayed(const std::string& key);
+		ATTRIBUTE_NONNULL_ std::string *resolve_delayed_recurse(const std::string& key, WordUnorderedSet *visited, const char **errtext, std::string *errvar);
 
 		/**
 		Create defaults and main_map with all variables
 		(including all values required by delayed references).
-		@arg has_delayed is initialized to corresponding keys
+		has_delayed is initialized to corresponding keys
 		**/
-		ATTRIBUTE_NONNULL_ void read_undelayed(WordUnorderedSet *has_delayed);
+		void read_undelayed();
 		/**
 		Recursively join key and its delayed references to
 		main_map and default; set has_delayed if appropriate
 		**/
-		ATTRIBUTE_NONNULL((3)) void join_key(const std::string& key, WordUnorderedSet *has_delayed, bool add_top_to_defaults, const WordUnorderedSet *exclude_defaults);
-		ATTRIBUTE_NONNULL((4)) void join_key_rec(const std::string& key, const std::string& val, WordUnorderedSet *has_delayed, const WordUnorderedSet *exclude_defaults);
-		ATTRIBUTE_NONNULL((3)) void join_key_if_new(const std::string& key, WordUnorderedSet *has_delayed, const WordUnorderedSet *exclude_defaults);
+		void join_key(const std::string& key, bool add_top_to_defaults, const WordUnorderedSet *exclude_defaults);
+		void join_key_rec(const std::string& key, const std::string& val, const WordUnorderedSet *exclude_defaults);
+		void join_key_if_new(const std::string& key, const WordUnorderedSet *exclude_defaults);
 
 		typedef uint8_t DelayvarFlags;
 		static CONSTEXPR const DelayvarFlags
@@ -13,7 +13,10 @@
 #include "main/main.h"
 #include <config.h>  // IWYU pragma: keep
 
+#include <unistd.h>
+
 #include <csignal>  /* signal handlers */
+#include <cstdio>
 #include <cstdlib>
 #ifdef ENABLE_NLS
 #include <clocale>
@@ -22,6 +25,7 @@
 #include <string>
 
 #include "eixTk/attribute.h"
+#include "eixTk/dialect.h"
 #include "eixTk/formated.h"
 #include "eixTk/i18n.h"
 #include "eixTk/likely.h"
@@ -111,6 +115,11 @@ If several are selected, main() will select depending on the call name.
 
 using std::string;
 
+/**
+The size of the stdout buffer if the output is not a terminal
+**/
+static CONSTEXPR const std::size_t OUTPUT_BUFFER_SIZE = 64 * 1024;
+
 /**
 The name under which we have been called.
 **/
@@ -226,6 +235,11 @@ int main(int argc, char** argv) {
 	std::signal(SIGSEGV, sig_handler);
 #endif
 
+	/* Output which is not read interactively is written in large chunks */
+	if(isatty(1) == 0) {
+		std::setvbuf(stdout, NULLPTR, _IOFBF, OUTPUT_BUFFER_SIZE);
+	}
+
 	string my_program_name(argv[0]);
 	sanitize_filename(&my_program_name);
 	program_name = my_program_name.c_str();
@@ -15,6 +15,7 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <utility>
@@ -29,7 +30,6 @@
 #include "eixTk/outputstring.h"
 #include "eixTk/stringtypes.h"
 #include "eixTk/sysutils.h"
-#include "eixTk/unordered_map.h"
 #include "eixrc/eixrc.h"
 #include "output/formatstring.h"
 #include "portage/conf/portagesettings.h"
@@ -326,6 +326,61 @@ bool PrintFormat::have_virtual(const Package *p, bool nonvirtual) const {
 	return false;
 }
 
+/**
+A perfect hash for the names of a constant table: init() chooses a seed
+such that the (distinct) names of the table get distinct slots.
+Thus, a lookup needs only one hash computation and one string comparison.
+**/
+template<typename T, unsigned int Bits> class PerfectHash {
+	protected:
+		/**
+		0 means empty, otherwise 1 + the index in table
+		**/
+		typedef unsigned short Slot;
+		Slot slots[1U << Bits];
+		const T *table;
+		unsigned int seed;
+
+		ATTRIBUTE_PURE static unsigned int hash(unsigned int s, const char *name, string::size_type len) {
+			// FNV-1a
+			unsigned int h(2166136261U ^ s);
+			for(string::size_type i(0); likely(i < len); ++i) {
+				h ^= static_cast<unsigned char>(name[i]);
+				h *= 16777619U;
+			}
+			return ((h ^ (h >> Bits)) & ((1U << Bits) - 1));
+		}
+
+		ATTRIBUTE_NONNULL_ bool fill(const T *begin, const T *end) {
+			std::fill(slots, slots + (1U << Bits), Slot(0));
+			for(const T *it(begin); likely(it != end); ++it) {
+				Slot& slot(slots[hash(seed, it->name, std::strlen(it->name))]);
+				if(unlikely(slot != 0)) {
+					eix_assert_paranoic(std::strcmp(table[slot - 1].name, it->name) != 0);
+					return false;
+				}
+				slot = static_cast<Slot>(it - begin + 1);
+			}
+			return true;
+		}
+
+	public:
+		ATTRIBUTE_NONNULL_ void init(const T *begin, const T *end) {
+			table = begin;
+			for(seed = 0; unlikely(!fill(begin, end)); ++seed) {
+			}
+		}
+
+		ATTRIBUTE_PURE const T *find(const string& s) const {
+			Slot slot(slots[hash(seed, s.c_str(), s.size())]);
+			if(slot == 0) {
+				return NULLPTR;
+			}
+			const T *entry(table + (slot - 1));
+			return ((s.compare(entry->name) == 0) ? entry : NULLPTR);
+		}
+};
+
 class Scanner {
 	public:
 		enum Diff {
@@ -342,224 +397,259 @@ class Scanner {
 		typedef void (PrintFormat::*ColonVar)(Package *pkg, const string& after_colon) const;
 		typedef void (PrintFormat::*ColonOther)(OutputString *s, Package *pkg, const string& after_colon) const;
 
-	protected:
-		UNORDERED_MAP<string, Diff> diff;
-		UNORDERED_MAP<string, pair<Plain, Prop> > plain;
-		UNORDERED_MAP<string, ColonVar> colon_var;
-		UNORDERED_MAP<string, ColonOther> colon_other;
-
-		ATTRIBUTE_NONNULL_ void prop_diff(const char *s, Diff diffprop) {
-			diff[s] = diffprop;
-		}
+		class DiffEntry {
+			public:
+				const char *name;
+				Diff diff;
+		};
 
-		ATTRIBUTE_NONNULL_ void prop_colon_pkg(const char *s, ColonVar colfunc) {
-			colon_var[s] = colfunc;
-		}
+		class PlainEntry {
+			public:
+				const char *name;
+				Plain plain;
+				Prop prop;
+		};
 
-		ATTRIBUTE_NONNULL_ void prop_colon_ver(const char *s, ColonOther colfunc) {
-			colon_other[s] = colfunc;
-		}
+		class ColonVarEntry {
+			public:
+				const char *name;
+				ColonVar colon_var;
+		};
 
-		ATTRIBUTE_NONNULL_ void prop_pkg(const char *s, Plain plainfunc) {
-			plain[s] = pair<Plain, Prop>(plainfunc, PKG);
-		}
+		class ColonOtherEntry {
+			public:
+				const char *name;
+				ColonOther colon_other;
+		};
 
-		ATTRIBUTE_NONNULL_ void prop_ver(const char *s, Plain plainfunc) {
-			plain[s] = pair<Plain, Prop>(plainfunc, VER);
-		}
+	protected:
+		/**
+		The tables are constant so that they need no initialization code
+		**/
+		static const DiffEntry diff_table[];
+		static const PlainEntry plain_table[];
+		static const ColonVarEntry colon_var_table[];
+		static const ColonOtherEntry colon_other_table[];
+
+		PerfectHash<DiffEntry, 5> diff;
+		PerfectHash<PlainEntry, 12> plain;
+		PerfectHash<ColonVarEntry, 6> colon_var;
+		PerfectHash<ColonOtherEntry, 2> colon_other;
 
 	public:
-		Scanner() {
-			prop_diff("better", DIFF_BETTER);
-			prop_diff("bestbetter", DIFF_BESTBETTER);
-			prop_diff("worse", DIFF_WORSE);
-			prop_diff("bestworse", DIFF_BESTWORSE);
-			prop_diff("differ", DIFF_DIFFER);
-			prop_diff("bestdiffer", DIFF_BESTDIFFER);
-			prop_colon_ver("date", &PrintFormat::COLON_VER_DATE);
-			prop_colon_pkg("availableversions", &PrintFormat::COLON_PKG_AVAILABLEVERSIONS);
-			prop_colon_pkg("markedversions", &PrintFormat::COLON_PKG_MARKEDVERSIONS);
-			prop_colon_pkg("bestversion*", &PrintFormat::COLON_PKG_BESTVERSIONS);
-			prop_colon_pkg("bestversion", &PrintFormat::COLON_PKG_BESTVERSION);
-			prop_colon_pkg("bestslotversions*", &PrintFormat::COLON_PKG_BESTSLOTVERSIONSS);
-			prop_colon_pkg("bestslotversions", &PrintFormat::COLON_PKG_BESTSLOTVERSIONS);
-			prop_colon_pkg("bestslotupgradeversions*", &PrintFormat::COLON_PKG_BESTSLOTUPGRADEVERSIONSS);
-			prop_colon_pkg("bestslotupgradeversions", &PrintFormat::COLON_PKG_BESTSLOTUPGRADEVERSIONS);
-			prop_colon_pkg("installedversions", &PrintFormat::COLON_PKG_INSTALLEDVERSIONS);
-			prop_pkg("installed", &PrintFormat::PKG_INSTALLED);
-			prop_pkg("versionlines", &PrintFormat::PKG_VERSIONLINES);
-			prop_pkg("slotsorted", &PrintFormat::PKG_SLOTSORTED);
-			prop_pkg("color", &PrintFormat::PKG_COLOR);
-			prop_pkg("havebest", &PrintFormat::PKG_HAVEBEST);
-			prop_pkg("havebest*", &PrintFormat::PKG_HAVEBESTS);
-			prop_pkg("category", &PrintFormat::PKG_CATEGORY);
-			prop_pkg("name", &PrintFormat::PKG_NAME);
-			prop_pkg("description", &PrintFormat::PKG_DESCRIPTION);
-			prop_pkg("homepage", &PrintFormat::PKG_HOMEPAGE);
-			prop_pkg("licenses", &PrintFormat::PKG_LICENSES);
-			prop_pkg("mainrepo", &PrintFormat::PKG_MAINREPO);
-			prop_pkg("overlaykey", &PrintFormat::PKG_OVERLAYKEY);
-			prop_pkg("overlayname", &PrintFormat::PKG_OVERLAYNAME);
-			prop_pkg("binary", &PrintFormat::PKG_BINARY);
-			prop_pkg("system", &PrintFormat::PKG_SYSTEM);
-			prop_pkg("profile", &PrintFormat::PKG_PROFILE);
-			prop_pkg("world", &PrintFormat::PKG_WORLD);
-			prop_pkg("world_sets", &PrintFormat::PKG_WORLD_SETS);
-			prop_pkg("setnames", &PrintFormat::PKG_SETNAMES);
-			prop_pkg("allsetnames", &PrintFormat::PKG_ALLSETNAMES);
-			prop_pkg("upgrade", &PrintFormat::PKG_UPGRADE);
-			prop_pkg("upgradeorinstall", &PrintFormat::PKG_UPGRADEORINSTALL);
-			prop_pkg("bestupgrade", &PrintFormat::PKG_BESTUPGRADE);
-			prop_pkg("bestupgradeorinstall", &PrintFormat::PKG_BESTUPGRADEORINSTALL);
-			prop_pkg("downgrade", &PrintFormat::PKG_DOWNGRADE);
-			prop_pkg("bestdowngrade", &PrintFormat::PKG_BESTDOWNGRADE);
-			prop_pkg("recommend", &PrintFormat::PKG_RECOMMEND);
-			prop_pkg("recommendorinstall", &PrintFormat::PKG_RECOMMENDORINSTALL);
-			prop_pkg("bestrecommend", &PrintFormat::PKG_BESTRECOMMEND);
-			prop_pkg("bestrecommendorinstall", &PrintFormat::PKG_BESTRECOMMENDORINSTALL);
-			prop_pkg("marked", &PrintFormat::PKG_MARKED);
-			prop_pkg("havemarkedversion", &PrintFormat::PKG_HAVEMARKEDVERSION);
-			prop_pkg("slots", &PrintFormat::PKG_SLOTS);
-			prop_pkg("slotted", &PrintFormat::PKG_SLOTTED);
-			prop_pkg("havevirtual", &PrintFormat::PKG_HAVEVIRTUAL);
-			prop_pkg("havenonvirtual", &PrintFormat::PKG_HAVENONVIRTUAL);
-			prop_pkg("havecolliuse", &PrintFormat::PKG_HAVECOLLIUSE);
-			prop_pkg("colliuse0", &PrintFormat::PKG_COLLIUSE0);
-			prop_pkg("colliuse*", &PrintFormat::PKG_COLLIUSES);
-			prop_pkg("colliuse", &PrintFormat::PKG_COLLIUSE);
-			prop_ver("first", &PrintFormat::VER_FIRST);
-			prop_ver("last", &PrintFormat::VER_LAST);
-			prop_ver("slotfirst", &PrintFormat::VER_SLOTFIRST);
-			prop_ver("slotlast", &PrintFormat::VER_SLOTLAST);
-			prop_ver("oneslot", &PrintFormat::VER_ONESLOT);
-			prop_ver("fullslot", &PrintFormat::VER_FULLSLOT);
-			prop_ver("isfullslot", &PrintFormat::VER_ISFULLSLOT);
-			prop_ver("slot", &PrintFormat::VER_SLOT);
-			prop_ver("isslot", &PrintFormat::VER_ISSLOT);
-			prop_ver("subslot", &PrintFormat::VER_SUBSLOT);
-			prop_ver("issubslot", &PrintFormat::VER_ISSUBSLOT);
-			prop_ver("srcuri", &PrintFormat::VER_SRCURI);
-			prop_ver("havesrcuri", &PrintFormat::VER_HAVESRCURI);
-			prop_ver("eapi", &PrintFormat::VER_EAPI);
-			prop_ver("version", &PrintFormat::VER_VERSION);
-			prop_ver("plainversion", &PrintFormat::VER_PLAINVERSION);
-			prop_ver("revision", &PrintFormat::VER_REVISION);
-			prop_ver("overlaynum", &PrintFormat::VER_OVERLAYNUM);
-			prop_ver("overlayver", &PrintFormat::VER_OVERLAYVER);
-			prop_ver("overlayplainname*", &PrintFormat::VER_OVERLAYPLAINNAMES);
-			prop_ver("overlayplainname", &PrintFormat::VER_OVERLAYPLAINNAME);
-			prop_ver("overlayvername*", &PrintFormat::VER_OVERLAYVERNAMES);
-			prop_ver("overlayvername", &PrintFormat::VER_OVERLAYVERNAME);
-			prop_ver("versionkeywords*", &PrintFormat::VER_VERSIONKEYWORDSS);
-			prop_ver("versionkeywords", &PrintFormat::VER_VERSIONKEYWORDS);
-			prop_ver("versionekeywords", &PrintFormat::VER_VERSIONEKEYWORDS);
-			prop_ver("isbestupgradeslot*", &PrintFormat::VER_ISBESTUPGRADESLOTS);
-			prop_ver("isbestupgradeslot", &PrintFormat::VER_ISBESTUPGRADESLOT);
-			prop_ver("isbestupgrade*", &PrintFormat::VER_ISBESTUPGRADES);
-			prop_ver("isbestupgrade", &PrintFormat::VER_ISBESTUPGRADE);
-			prop_ver("markedversion", &PrintFormat::VER_MARKEDVERSION);
-			prop_ver("installedversion", &PrintFormat::VER_INSTALLEDVERSION);
-			prop_ver("haveuse", &PrintFormat::VER_HAVEUSE);
-			prop_ver("use0", &PrintFormat::VER_USE0);
-			prop_ver("use*", &PrintFormat::VER_USES);
-			prop_ver("use", &PrintFormat::VER_USE);
-			prop_ver("requireduse", &PrintFormat::VER_REQUIREDUSE);
-			prop_ver("haverequireduse", &PrintFormat::VER_HAVEREQUIREDUSE);
-			prop_ver("virtual", &PrintFormat::VER_VIRTUAL);
-			prop_ver("isbinary", &PrintFormat::VER_ISBINARY);
-			prop_ver("istbz", &PrintFormat::VER_ISTBZ);
-			prop_ver("ispak", &PrintFormat::VER_ISPAK);
-			prop_ver("ismultipak", &PrintFormat::VER_ISMULTIPAK);
-			prop_ver("pakcount", &PrintFormat::VER_PAKCOUNT);
-			prop_ver("restrict", &PrintFormat::VER_RESTRICT);
-			prop_ver("restrictfetch", &PrintFormat::VER_RESTRICTFETCH);
-			prop_ver("restrictmirror", &PrintFormat::VER_RESTRICTMIRROR);
-			prop_ver("restrictprimaryuri", &PrintFormat::VER_RESTRICTPRIMARYURI);
-			prop_ver("restrictbinchecks", &PrintFormat::VER_RESTRICTBINCHECKS);
-			prop_ver("restrictstrip", &PrintFormat::VER_RESTRICTSTRIP);
-			prop_ver("restricttest", &PrintFormat::VER_RESTRICTTEST);
-			prop_ver("restrictuserpriv", &PrintFormat::VER_RESTRICTUSERPRIV);
-			prop_ver("restrictinstallsources", &PrintFormat::VER_RESTRICTINSTALLSOURCES);
-			prop_ver("restrictbindist", &PrintFormat::VER_RESTRICTBINDIST);
-			prop_ver("restrictparallel", &PrintFormat::VER_RESTRICTPARALLEL);
-			prop_ver("properties", &PrintFormat::VER_PROPERTIES);
-			prop_ver("propertiesinteractive", &PrintFormat::VER_PROPERTIESINTERACTIVE);
-			prop_ver("propertieslive", &PrintFormat::VER_PROPERTIESLIVE);
-			prop_ver("propertiesvirtual", &PrintFormat::VER_PROPERTIESVIRTUAL);
-			prop_ver("propertiesset", &PrintFormat::VER_PROPERTIESSET);
-			prop_ver("havedepend", &PrintFormat::VER_HAVEDEPEND);
-			prop_ver("haverdepend", &PrintFormat::VER_HAVERDEPEND);
-			prop_ver("havepdepend", &PrintFormat::VER_HAVEPDEPEND);
-			prop_ver("havebdepend", &PrintFormat::VER_HAVEBDEPEND);
-			prop_ver("havedeps", &PrintFormat::VER_HAVEDEPS);
-			prop_ver("depend*", &PrintFormat::VER_DEPENDS);
-			prop_ver("depend", &PrintFormat::VER_DEPEND);
-			prop_ver("rdepend*", &PrintFormat::VER_RDEPENDS);
-			prop_ver("rdepend", &PrintFormat::VER_RDEPEND);
-			prop_ver("pdepend*", &PrintFormat::VER_PDEPENDS);
-			prop_ver("pdepend", &PrintFormat::VER_PDEPEND);
-			prop_ver("bdepend*", &PrintFormat::VER_BDEPENDS);
-			prop_ver("bdepend", &PrintFormat::VER_BDEPEND);
-			prop_ver("ishardmasked", &PrintFormat::VER_ISHARDMASKED);
-			prop_ver("isprofilemasked", &PrintFormat::VER_ISPROFILEMASKED);
-			prop_ver("ismasked", &PrintFormat::VER_ISMASKED);
-			prop_ver("isstable", &PrintFormat::VER_ISSTABLE);
-			prop_ver("isunstable", &PrintFormat::VER_ISUNSTABLE);
-			prop_ver("isalienstable", &PrintFormat::VER_ISALIENSTABLE);
-			prop_ver("isalienunstable", &PrintFormat::VER_ISALIENUNSTABLE);
-			prop_ver("ismissingkeyword", &PrintFormat::VER_ISMISSINGKEYWORD);
-			prop_ver("isminuskeyword", &PrintFormat::VER_ISMINUSKEYWORD);
-			prop_ver("isminusunstable", &PrintFormat::VER_ISMINUSUNSTABLE);
-			prop_ver("isminusasterisk", &PrintFormat::VER_ISMINUSASTERISK);
-			prop_ver("washardmasked", &PrintFormat::VER_WASHARDMASKED);
-			prop_ver("wasprofilemasked", &PrintFormat::VER_WASPROFILEMASKED);
-			prop_ver("wasmasked", &PrintFormat::VER_WASMASKED);
-			prop_ver("wasstable", &PrintFormat::VER_WASSTABLE);
-			prop_ver("wasunstable", &PrintFormat::VER_WASUNSTABLE);
-			prop_ver("wasalienstable", &PrintFormat::VER_WASALIENSTABLE);
-			prop_ver("wasalienunstable", &PrintFormat::VER_WASALIENUNSTABLE);
-			prop_ver("wasmissingkeyword", &PrintFormat::VER_WASMISSINGKEYWORD);
-			prop_ver("wasminuskeyword", &PrintFormat::VER_WASMINUSKEYWORD);
-			prop_ver("wasminusunstable", &PrintFormat::VER_WASMINUSUNSTABLE);
-			prop_ver("wasminusasterisK", &PrintFormat::VER_WASMINUSASTERISK);
-			prop_ver("havemaskreasons", &PrintFormat::VER_HAVEMASKREASONS);
-			prop_ver("maskreasons", &PrintFormat::VER_MASKREASONS);
-			prop_ver("maskreasons*", &PrintFormat::VER_MASKREASONSS);
-		}
+		Scanner();
 
 		ATTRIBUTE_PURE Diff get_diff(const string& s) const {
-			UNORDERED_MAP<string, Diff>::const_iterator it(diff.find(s));
-			return ((it == diff.end()) ? DIFF_NONE : it->second);
+			const DiffEntry *it(diff.find(s));
+			return ((it == NULLPTR) ? DIFF_NONE : it->diff);
 		}
 
 		ATTRIBUTE_NONNULL_ ColonVar get_colon_var(const string& s, Prop *p) const {
-			UNORDERED_MAP<string, ColonVar>::const_iterator it(colon_var.find(s));
-			if(it == colon_var.end()) {
+			const ColonVarEntry *it(colon_var.find(s));
+			if(it == NULLPTR) {
 				return NULLPTR;
 			}
 			*p = PKG;
-			return it->second;
+			return it->colon_var;
 		}
 
 		ATTRIBUTE_NONNULL_ ColonOther get_colon_other(const string& s, Prop *p) const {
-			UNORDERED_MAP<string, ColonOther>::const_iterator it(colon_other.find(s));
-			if(it == colon_other.end()) {
+			const ColonOtherEntry *it(colon_other.find(s));
+			if(it == NULLPTR) {
 				return NULLPTR;
 			}
 			*p = VER;
-			return it->second;
+			return it->colon_other;
 		}
 
 		ATTRIBUTE_NONNULL_ Plain get_plain(const string& s, Prop *p) const {
-			UNORDERED_MAP<string, pair<Plain, Prop> >::const_iterator it(plain.find(s));
-			if(it == plain.end()) {
+			const PlainEntry *it(plain.find(s));
+			if(it == NULLPTR) {
 				return NULLPTR;
 			}
-			*p = it->second.second;
-			return it->second.first;
+			*p = it->prop;
+			return it->plain;
 		}
 };
 
+const Scanner::DiffEntry Scanner::diff_table[] = {
+	{ "better", DIFF_BETTER },
+	{ "bestbetter", DIFF_BESTBETTER },
+	{ "worse", DIFF_WORSE },
+	{ "bestworse", DIFF_BESTWORSE },
+	{ "differ", DIFF_DIFFER },
+	{ "bestdiffer", DIFF_BESTDIFFER },
+};
+
+const Scanner::ColonVarEntry Scanner::colon_var_table[] = {
+	{ "availableversions", &PrintFormat::COLON_PKG_AVAILABLEVERSIONS },
+	{ "markedversions", &PrintFormat::COLON_PKG_MARKEDVERSIONS },
+	{ "bestversion*", &PrintFormat::COLON_PKG_BESTVERSIONS },
+	{ "bestversion", &PrintFormat::COLON_PKG_BESTVERSION },
+	{ "bestslotversions*", &PrintFormat::COLON_PKG_BESTSLOTVERSIONSS },
+	{ "bestslotversions", &PrintFormat::COLON_PKG_BESTSLOTVERSIONS },
+	{ "bestslotupgradeversions*", &PrintFormat::COLON_PKG_BESTSLOTUPGRADEVERSIONSS },
+	{ "bestslotupgradeversions", &PrintFormat::COLON_PKG_BESTSLOTUPGRADEVERSIONS },
+	{ "installedversions", &PrintFormat::COLON_PKG_INSTALLEDVERSIONS },
+};
+
+const Scanner::ColonOtherEntry Scanner::colon_other_table[] = {
+	{ "date", &PrintFormat::COLON_VER_DATE },
+};
+
+const Scanner::PlainEntry Scanner::plain_table[] = {
+	{ "installed", &PrintFormat::PKG_INSTALLED, PKG },
+	{ "versionlines", &PrintFormat::PKG_VERSIONLINES, PKG },
+	{ "slotsorted", &PrintFormat::PKG_SLOTSORTED, PKG },
+	{ "color", &PrintFormat::PKG_COLOR, PKG },
+	{ "havebest", &PrintFormat::PKG_HAVEBEST, PKG },
+	{ "havebest*", &PrintFormat::PKG_HAVEBESTS, PKG },
+	{ "category", &PrintFormat::PKG_CATEGORY, PKG },
+	{ "name", &PrintFormat::PKG_NAME, PKG },
+	{ "description", &PrintFormat::PKG_DESCRIPTION, PKG },
+	{ "homepage", &PrintFormat::PKG_HOMEPAGE, PKG },
+	{ "licenses", &PrintFormat::PKG_LICENSES, PKG },
+	{ "mainrepo", &PrintFormat::PKG_MAINREPO, PKG },
+	{ "overlaykey", &PrintFormat::PKG_OVERLAYKEY, PKG },
+	{ "overlayname", &PrintFormat::PKG_OVERLAYNAME, PKG },
+	{ "binary", &PrintFormat::PKG_BINARY, PKG },
+	{ "system", &PrintFormat::PKG_SYSTEM, PKG },
+	{ "profile", &PrintFormat::PKG_PROFILE, PKG },
+	{ "world", &PrintFormat::PKG_WORLD, PKG },
+	{ "world_sets", &PrintFormat::PKG_WORLD_SETS, PKG },
+	{ "setnames", &PrintFormat::PKG_SETNAMES, PKG },
+	{ "allsetnames", &PrintFormat::PKG_ALLSETNAMES, PKG },
+	{ "upgrade", &PrintFormat::PKG_UPGRADE, PKG },
+	{ "upgradeorinstall", &PrintFormat::PKG_UPGRADEORINSTALL, PKG },
+	{ "bestupgrade", &PrintFormat::PKG_BESTUPGRADE, PKG },
+	{ "bestupgradeorinstall", &PrintFormat::PKG_BESTUPGRADEORINSTALL, PKG },
+	{ "downgrade", &PrintFormat::PKG_DOWNGRADE, PKG },
+	{ "bestdowngrade", &PrintFormat::PKG_BESTDOWNGRADE, PKG },
+	{ "recommend", &PrintFormat::PKG_RECOMMEND, PKG },
+	{ "recommendorinstall", &PrintFormat::PKG_RECOMMENDORINSTALL, PKG },
+	{ "bestrecommend", &PrintFormat::PKG_BESTRECOMMEND, PKG },
+	{ "bestrecommendorinstall", &PrintFormat::PKG_BESTRECOMMENDORINSTALL, PKG },
+	{ "marked", &PrintFormat::PKG_MARKED, PKG },
+	{ "havemarkedversion", &PrintFormat::PKG_HAVEMARKEDVERSION, PKG },
+	{ "slots", &PrintFormat::PKG_SLOTS, PKG },
+	{ "slotted", &PrintFormat::PKG_SLOTTED, PKG },
+	{ "havevirtual", &PrintFormat::PKG_HAVEVIRTUAL, PKG },
+	{ "havenonvirtual", &PrintFormat::PKG_HAVENONVIRTUAL, PKG },
+	{ "havecolliuse", &PrintFormat::PKG_HAVECOLLIUSE, PKG },
+	{ "colliuse0", &PrintFormat::PKG_COLLIUSE0, PKG },
+	{ "colliuse*", &PrintFormat::PKG_COLLIUSES, PKG },
+	{ "colliuse", &PrintFormat::PKG_COLLIUSE, PKG },
+	{ "first", &PrintFormat::VER_FIRST, VER },
+	{ "last", &PrintFormat::VER_LAST, VER },
+	{ "slotfirst", &PrintFormat::VER_SLOTFIRST, VER },
+	{ "slotlast", &PrintFormat::VER_SLOTLAST, VER },
+	{ "oneslot", &PrintFormat::VER_ONESLOT, VER },
+	{ "fullslot", &PrintFormat::VER_FULLSLOT, VER },
+	{ "isfullslot", &PrintFormat::VER_ISFULLSLOT, VER },
+	{ "slot", &PrintFormat::VER_SLOT, VER },
+	{ "isslot", &PrintFormat::VER_ISSLOT, VER },
+	{ "subslot", &PrintFormat::VER_SUBSLOT, VER },
+	{ "issubslot", &PrintFormat::VER_ISSUBSLOT, VER },
+	{ "srcuri", &PrintFormat::VER_SRCURI, VER },
+	{ "havesrcuri", &PrintFormat::VER_HAVESRCURI, VER },
+	{ "eapi", &PrintFormat::VER_EAPI, VER },
+	{ "version", &PrintFormat::VER_VERSION, VER },
+	{ "plainversion", &PrintFormat::VER_PLAINVERSION, VER },
+	{ "revision", &PrintFormat::VER_REVISION, VER },
+	{ "overlaynum", &PrintFormat::VER_OVERLAYNUM, VER },
+	{ "overlayver", &PrintFormat::VER_OVERLAYVER, VER },
+	{ "overlayplainname*", &PrintFormat::VER_OVERLAYPLAINNAMES, VER },
+	{ "overlayplainname", &PrintFormat::VER_OVERLAYPLAINNAME, VER },
+	{ "overlayvername*", &PrintFormat::VER_OVERLAYVERNAMES, VER },
+	{ "overlayvername", &PrintFormat::VER_OVERLAYVERNAME, VER },
+	{ "versionkeywords*", &PrintFormat::VER_VERSIONKEYWORDSS, VER },
+	{ "versionkeywords", &PrintFormat::VER_VERSIONKEYWORDS, VER },
+	{ "versionekeywords", &PrintFormat::VER_VERSIONEKEYWORDS, VER },
+	{ "isbestupgradeslot*", &PrintFormat::VER_ISBESTUPGRADESLOTS, VER },
+	{ "isbestupgradeslot", &PrintFormat::VER_ISBESTUPGRADESLOT, VER },
+	{ "isbestupgrade*", &PrintFormat::VER_ISBESTUPGRADES, VER },
+	{ "isbestupgrade", &PrintFormat::VER_ISBESTUPGRADE, VER },
+	{ "markedversion", &PrintFormat::VER_MARKEDVERSION, VER },
+	{ "installedversion", &PrintFormat::VER_INSTALLEDVERSION, VER },
+	{ "haveuse", &PrintFormat::VER_HAVEUSE, VER },
+	{ "use0", &PrintFormat::VER_USE0, VER },
+	{ "use*", &PrintFormat::VER_USES, VER },
+	{ "use", &PrintFormat::VER_USE, VER },
+	{ "requireduse", &PrintFormat::VER_REQUIREDUSE, VER },
+	{ "haverequireduse", &PrintFormat::VER_HAVEREQUIREDUSE, VER },
+	{ "virtual", &PrintFormat::VER_VIRTUAL, VER },
+	{ "isbinary", &PrintFormat::VER_ISBINARY, VER },
+	{ "istbz", &PrintFormat::VER_ISTBZ, VER },
+	{ "ispak", &PrintFormat::VER_ISPAK, VER },
+	{ "ismultipak", &PrintFormat::VER_ISMULTIPAK, VER },
+	{ "pakcount", &PrintFormat::VER_PAKCOUNT, VER },
+	{ "restrict", &PrintFormat::VER_RESTRICT, VER },
+	{ "restrictfetch", &PrintFormat::VER_RESTRICTFETCH, VER },
+	{ "restrictmirror", &PrintFormat::VER_RESTRICTMIRROR, VER },
+	{ "restrictprimaryuri", &PrintFormat::VER_RESTRICTPRIMARYURI, VER },
+	{ "restrictbinchecks", &PrintFormat::VER_RESTRICTBINCHECKS, VER },
+	{ "restrictstrip", &PrintFormat::VER_RESTRICTSTRIP, VER },
+	{ "restricttest", &PrintFormat::VER_RESTRICTTEST, VER },
+	{ "restrictuserpriv", &PrintFormat::VER_RESTRICTUSERPRIV, VER },
+	{ "restrictinstallsources", &PrintFormat::VER_RESTRICTINSTALLSOURCES, VER },
+	{ "restrictbindist", &PrintFormat::VER_RESTRICTBINDIST, VER },
+	{ "restrictparallel", &PrintFormat::VER_RESTRICTPARALLEL, VER },
+	{ "properties", &PrintFormat::VER_PROPERTIES, VER },
+	{ "propertiesinteractive", &PrintFormat::VER_PROPERTIESINTERACTIVE, VER },
+	{ "propertieslive", &PrintFormat::VER_PROPERTIESLIVE, VER },
+	{ "propertiesvirtual", &PrintFormat::VER_PROPERTIESVIRTUAL, VER },
+	{ "propertiesset", &PrintFormat::VER_PROPERTIESSET, VER },
+	{ "havedepend", &PrintFormat::VER_HAVEDEPEND, VER },
+	{ "haverdepend", &PrintFormat::VER_HAVERDEPEND, VER },
+	{ "havepdepend", &PrintFormat::VER_HAVEPDEPEND, VER },
+	{ "havebdepend", &PrintFormat::VER_HAVEBDEPEND, VER },
+	{ "havedeps", &PrintFormat::VER_HAVEDEPS, VER },
+	{ "depend*", &PrintFormat::VER_DEPENDS, VER },
+	{ "depend", &PrintFormat::VER_DEPEND, VER },
+	{ "rdepend*", &PrintFormat::VER_RDEPENDS, VER },
+	{ "rdepend", &PrintFormat::VER_RDEPEND, VER },
+	{ "pdepend*", &PrintFormat::VER_PDEPENDS, VER },
+	{ "pdepend", &PrintFormat::VER_PDEPEND, VER },
+	{ "bdepend*", &PrintFormat::VER_BDEPENDS, VER },
+	{ "bdepend", &PrintFormat::VER_BDEPEND, VER },
+	{ "ishardmasked", &PrintFormat::VER_ISHARDMASKED, VER },
+	{ "isprofilemasked", &PrintFormat::VER_ISPROFILEMASKED, VER },
+	{ "ismasked", &PrintFormat::VER_ISMASKED, VER },
+	{ "isstable", &PrintFormat::VER_ISSTABLE, VER },
+	{ "isunstable", &PrintFormat::VER_ISUNSTABLE, VER },
+	{ "isalienstable", &PrintFormat::VER_ISALIENSTABLE, VER },
+	{ "isalienunstable", &PrintFormat::VER_ISALIENUNSTABLE, VER },
+	{ "ismissingkeyword", &PrintFormat::VER_ISMISSINGKEYWORD, VER },
+	{ "isminuskeyword", &PrintFormat::VER_ISMINUSKEYWORD, VER },
+	{ "isminusunstable", &PrintFormat::VER_ISMINUSUNSTABLE, VER },
+	{ "isminusasterisk", &PrintFormat::VER_ISMINUSASTERISK, VER },
+	{ "washardmasked", &PrintFormat::VER_WASHARDMASKED, VER },
+	{ "wasprofilemasked", &PrintFormat::VER_WASPROFILEMASKED, VER },
+	{ "wasmasked", &PrintFormat::VER_WASMASKED, VER },
+	{ "wasstable", &PrintFormat::VER_WASSTABLE, VER },
+	{ "wasunstable", &PrintFormat::VER_WASUNSTABLE, VER },
+	{ "wasalienstable", &PrintFormat::VER_WASALIENSTABLE, VER },
+	{ "wasalienunstable", &PrintFormat::VER_WASALIENUNSTABLE, VER },
+	{ "wasmissingkeyword", &PrintFormat::VER_WASMISSINGKEYWORD, VER },
+	{ "wasminuskeyword", &PrintFormat::VER_WASMINUSKEYWORD, VER },
+	{ "wasminusunstable", &PrintFormat::VER_WASMINUSUNSTABLE, VER },
+	{ "wasminusasterisK", &PrintFormat::VER_WASMINUSASTERISK, VER },
+	{ "havemaskreasons", &PrintFormat::VER_HAVEMASKREASONS, VER },
+	{ "maskreasons", &PrintFormat::VER_MASKREASONS, VER },
+	{ "maskreasons*", &PrintFormat::VER_MASKREASONSS, VER },
+};
+
+#define TABLE_END(table) ((table) + sizeof(table) / sizeof(*(table)))
+
+Scanner::Scanner() {
+	diff.init(diff_table, TABLE_END(diff_table));
+	plain.init(plain_table, TABLE_END(plain_table));
+	colon_var.init(colon_var_table, TABLE_END(colon_var_table));
+	colon_other.init(colon_other_table, TABLE_END(colon_other_table));
+}
+
+#undef TABLE_END
+
 static Scanner *scanner = NULLPTR;
 
 void PrintFormat::init_static() {
@@ -0,0 +1,51 @@
+// vim:set noet cinoptions= sw=4 ts=4:
+// This file is part of the eix project and distributed under the
+// terms of the GNU General Public License v2.
+//
+// Copyright (c)
+//   Martin Väth <martin@mvath.de>
+
+#include "output/print-formats.h"
+#include <config.h>  // IWYU pragma: keep
+
+#include <set>
+
+#include "eixTk/dialect.h"
+#include "eixTk/likely.h"
+#include "eixTk/null.h"
+#include "eixTk/unordered_set.h"
+#include "portage/basicversion.h"
+#include "portage/package.h"
+#include "portage/vardbpkg.h"
+#include "portage/version.h"
+
+using std::set;
+
+void PrintFormats::installed_versions(VersionSet *have_inst, Package *pkg, VarDbPkg *vardb, const DBHeader *header) {
+	if((unlikely(vardb == NULLPTR)) || !vardb->isInstalled(*pkg)) {
+		return;
+	}
+	set<BasicVersion> know_inst;
+	// First we check which versions are installed with correct overlays.
+	if(likely(header != NULLPTR)) {
+		// Package is a 'list' of Versions with added members ^^
+		for(Package::const_iterator ver(pkg->begin());
+			likely(ver != pkg->end()); ++ver) {
+			if(vardb->isInstalledVersion(*pkg, *ver, *header) > 0) {
+				know_inst.INSERT(**ver);
+				have_inst->INSERT(*ver);
+			}
+		}
+	}
+	// From the remaining ones we choose the last.
+	// The following should actually be const_reverse_iterator,
+	// but some compilers would then need a cast of rend(),
+	// see https://bugs.gentoo.org/show_bug.cgi?id=354071
+	for(Package::reverse_iterator ver(pkg->rbegin());
+		likely(ver != pkg->rend()); ++ver) {
+		if(know_inst.count(**ver) == 0) {
+			know_inst.INSERT(**ver);
+			have_inst->INSERT(*ver);
+		}
+	}
+}
@@ -11,9 +11,25 @@
 #include <config.h>  // IWYU pragma: keep
 
 #include "eixTk/attribute.h"
+#include "eixTk/unordered_set.h"
 #include "portage/package.h"
 
+class DBHeader;
+class VarDbPkg;
+class Version;
+
 class PrintFormats {
+	protected:
+		typedef UNORDERED_SET<const Version *> VersionSet;
+
+		/**
+		Collect the versions of pkg which are output as installed:
+		Those installed from the correct overlay and from the remaining
+		ones with the same BasicVersion the last.
+		The caller must check with vardb which are actually installed.
+		**/
+		ATTRIBUTE_NONNULL((1, 2)) static void installed_versions(VersionSet *have_inst, Package *pkg, VarDbPkg *vardb, const DBHeader *header);
+
 	public:
 		virtual void start() {}
 		virtual ATTRIBUTE_NONNULL_ void package(Package *) {}
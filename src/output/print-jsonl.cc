@@ -0,0 +1,485 @@
+// vim:set noet cinoptions= sw=4 ts=4:
+// This file is part of the eix project and distributed under the
+// terms of the GNU General Public License v2.
+//
+// Copyright (c)
+//   Martin Väth <martin@mvath.de>
+
+#include "output/print-jsonl.h"
+#include <config.h>  // IWYU pragma: keep
+
+#include <cstdio>
+
+#include <string>
+
+#include "database/header.h"
+#include "eixTk/attribute.h"
+#include "eixTk/dialect.h"
+#include "eixTk/formated.h"
+#include "eixTk/likely.h"
+#include "eixTk/null.h"
+#include "eixTk/stringtypes.h"
+#include "output/formatstring.h"
+#include "portage/basicversion.h"
+#include "portage/depend.h"
+#include "portage/extendedversion.h"
+#include "portage/instversion.h"
+#include "portage/keywords.h"
+#include "portage/overlay.h"
+#include "portage/package.h"
+#include "portage/set_stability.h"
+#include "portage/vardbpkg.h"
+#include "portage/version.h"
+
+using std::string;
+
+ATTRIBUTE_NONNULL_ inline static void append_key(string *out, const char *key);
+ATTRIBUTE_NONNULL_ inline static void append_member(string *out, const char *key, const string& value);
+ATTRIBUTE_NONNULL_ inline static void append_word(string *out, bool *first, const char *word);
+ATTRIBUTE_NONNULL_ ATTRIBUTE_PURE static string::size_type utf8_length(const char *str, const char *str_end);
+ATTRIBUTE_NONNULL_ static void append_mask_flags(string *out, const char *key, MaskFlags mask);
+ATTRIBUTE_NONNULL_ static void append_key_flags(string *out, const char *key, KeywordsFlags key_flags);
+ATTRIBUTE_NONNULL_ static void append_restrictions(string *out, ExtendedVersion::Restrict restrict);
+ATTRIBUTE_NONNULL_ static void append_properties(string *out, ExtendedVersion::Restrict props);
+
+/**
+Append ,"key": (the caller made sure that this is not the first member)
+**/
+inline static void append_key(string *out, const char *key) {
+	out->append(",\"");
+	out->append(key);
+	out->append("\":");
+}
+
+inline static void append_member(string *out, const char *key, const string& value) {
+	append_key(out, key);
+	PrintJsonl::append_string(out, value);
+}
+
+/**
+Append a list element which needs no escaping
+**/
+inline static void append_word(string *out, bool *first, const char *word) {
+	if(*first) {
+		*first = false;
+	} else {
+		out->append(1, ',');
+	}
+	out->append(1, '\"');
+	out->append(word);
+	out->append(1, '\"');
+}
+
+void PrintJsonl::package(Package *pkg) {
+	string *out(&buffer);
+	out->assign("{\"category\":");
+	append_string(out, pkg->category);
+	append_member(out, "name", pkg->name);
+	append_member(out, "description", pkg->desc);
+	append_member(out, "homepage", pkg->homepage);
+	append_member(out, "licenses", pkg->licenses);
+
+	VersionSet have_inst;
+	installed_versions(&have_inst, pkg, var_db_pkg, hdr);
+
+	append_key(out, "version");
+	out->append(1, '[');
+	for(Package::const_iterator ver(pkg->begin()); likely(ver != pkg->end()); ++ver) {
+		if(ver != pkg->begin()) {
+			out->append(1, ',');
+		}
+		out->append("{\"id\":");
+		append_string(out, ver->getFull());
+		append_member(out, "eapi", ver->eapi.get());
+
+		ExtendedVersion::Overlay overlay_key(ver->overlay_key);
+		if(unlikely(overlay_key != 0)) {
+			const OverlayIdent& overlay(hdr->getOverlay(overlay_key));
+			if(!overlay.label.empty()) {
+				append_member(out, "repository", overlay.label);
+			}
+			if(!(overlay.path.empty())) {
+				append_member(out, "overlay", overlay.path);
+			}
+			if(print_format->is_virtual(overlay_key)) {
+				out->append(",\"virtual\":true");
+			}
+		}
+		if(!ver->get_shortfullslot().empty()) {
+			append_member(out, "slot", ver->get_longfullslot());
+		}
+		if(!ver->src_uri.empty()) {
+			append_member(out, "src_uri", ver->src_uri);
+		}
+
+		InstVersion *installedVersion(NULLPTR);
+		if((have_inst.count(*ver) != 0) &&
+			var_db_pkg->isInstalled(*pkg, *ver, &installedVersion)) {
+			var_db_pkg->readInstDate(*pkg, installedVersion);
+			var_db_pkg->readEapi(*pkg, installedVersion);
+			var_db_pkg->readUse(*pkg, installedVersion);
+			append_key(out, "installed");
+			out->append("{\"date\":");
+			out->append(eix::format() % installedVersion->instDate);
+			append_member(out, "eapi", installedVersion->eapi.get());
+			const WordVec& inst_iuse(installedVersion->inst_iuse);
+			const WordSet& usedUse(installedVersion->usedUse);
+			for(int enabled(1); enabled >= 0; --enabled) {
+				append_key(out, (enabled ? "use_enabled" : "use_disabled"));
+				out->append(1, '[');
+				bool first(true);
+				for(WordVec::const_iterator iu(inst_iuse.begin());
+					likely(iu != inst_iuse.end()); ++iu) {
+					if((usedUse.count(*iu) != 0) != (enabled != 0)) {
+						continue;
+					}
+					if(likely(!first)) {
+						out->append(1, ',');
+					}
+					first = false;
+					append_string(out, *iu);
+				}
+				out->append(1, ']');
+			}
+			out->append(1, '}');
+		}
+
+		if(!(ver->iuse.empty())) {
+			const IUseSet::IUseStd& s(ver->iuse.asStd());
+			static CONSTEXPR const IUse::Flags iuse_flags[] = {
+				IUse::USEFLAGS_NORMAL,
+				IUse::USEFLAGS_PLUS,
+				IUse::USEFLAGS_MINUS
+			};
+			static CONSTEXPR const char *iuse_keys[] = {
+				"iuse",
+				"iuse_plus",
+				"iuse_minus"
+			};
+			for(int i(0); i < 3; ++i) {
+				bool first(true);
+				for(IUseSet::IUseStd::const_iterator it(s.begin()); likely(it != s.end()); ++it) {
+					if(((it->flags) & iuse_flags[i]) == 0) {
+						continue;
+					}
+					if(first) {
+						first = false;
+						append_key(out, iuse_keys[i]);
+						out->append(1, '[');
+					} else {
+						out->append(1, ',');
+					}
+					append_string(out, it->name());
+				}
+				if(!first) {
+					out->append(1, ']');
+				}
+			}
+		}
+		if(Version::use_required_use) {
+			const string& required_use(ver->required_use);
+			if(!(required_use.empty())) {
+				append_member(out, "required_use", required_use);
+			}
+		}
+
+		ExtendedVersion::Restrict props(ver->propertiesFlags);
+		if(unlikely(props != ExtendedVersion::PROPERTIES_NONE)) {
+			append_properties(out, props);
+		}
+		ExtendedVersion::Restrict restrict(ver->restrictFlags);
+		if(unlikely(restrict != ExtendedVersion::RESTRICT_NONE)) {
+			append_restrictions(out, restrict);
+		}
+
+		MaskFlags local_mask_flags;
+		KeywordsFlags local_key_flags;
+		stability->calc_version_flags(true, &local_mask_flags, &local_key_flags, *ver, pkg);
+		if(!local_mask_flags.empty()) {
+			append_mask_flags(out, "local_mask_flags", local_mask_flags);
+		}
+		if(!local_key_flags.empty()) {
+			append_key_flags(out, "local_key_flags", local_key_flags);
+		}
+		MaskFlags system_mask_flags;
+		KeywordsFlags system_key_flags;
+		stability->calc_version_flags(false, &system_mask_flags, &system_key_flags, *ver, pkg);
+		if(!system_mask_flags.empty()) {
+			append_mask_flags(out, "system_mask_flags", system_mask_flags);
+		}
+		if(!system_key_flags.empty()) {
+			append_key_flags(out, "system_key_flags", system_key_flags);
+		}
+
+		if(unlikely(ver->have_reasons())) {
+			const Version::Reasons *reasons_ptr(ver->reasons_ptr());
+			bool first(true);
+			for(Version::Reasons::const_iterator it(reasons_ptr->begin());
+				unlikely(it != reasons_ptr->end()); ++it) {
+				const WordVec *vec(it->asWordVecPtr());
+				if((vec == NULLPTR) || (vec->empty())) {
+					continue;
+				}
+				if(first) {
+					first = false;
+					append_key(out, "mask_reason");
+					out->append(1, '[');
+				} else {
+					out->append(1, ',');
+				}
+				out->append(1, '[');
+				for(WordVec::const_iterator wit(vec->begin());
+					likely(wit != vec->end()); ++wit) {
+					if(wit != vec->begin()) {
+						out->append(1, ',');
+					}
+					append_string(out, *wit);
+				}
+				out->append(1, ']');
+			}
+			if(!first) {
+				out->append(1, ']');
+			}
+		}
+
+		string full_kw(ver->get_full_keywords());
+		if(!full_kw.empty()) {
+			append_member(out, "keywords", full_kw);
+		}
+		string eff_kw(ver->get_effective_keywords());
+		if(unlikely(full_kw != eff_kw)) {
+			append_member(out, "keywords_effective", eff_kw);
+		}
+
+		if(Depend::use_depend) {
+			const string& depend = ver->depend.get_depend();
+			if(!depend.empty()) {
+				append_member(out, "depend", depend);
+			}
+			const string& rdepend = ver->depend.get_rdepend();
+			if(!rdepend.empty()) {
+				append_member(out, "rdepend", rdepend);
+			}
+			const string& pdepend = ver->depend.get_pdepend();
+			if(!pdepend.empty()) {
+				append_member(out, "pdepend", pdepend);
+			}
+			const string& bdepend = ver->depend.get_bdepend();
+			if(!bdepend.empty()) {
+				append_member(out, "bdepend", bdepend);
+			}
+		}
+		out->append(1, '}');
+	}
+	out->append("]}\n");
+	eix::write_output(stdout, *out);
+}  // NOLINT(readability/fn_size)
+
+/**
+@return the length of the valid UTF-8 sequence starting at str, or 0
+**/
+static string::size_type utf8_length(const char *str, const char *str_end) {
+	unsigned char c(*str);
+	string::size_type len;
+	// The range of the second byte excludes overlong forms,
+	// surrogates, and code points beyond U+10FFFF
+	unsigned char min(0x80), max(0xBF);
+	if((c >= 0xC2) && (c <= 0xDF)) {
+		len = 2;
+	} else if((c >= 0xE0) && (c <= 0xEF)) {
+		len = 3;
+		if(c == 0xE0) {
+			min = 0xA0;
+		} else if(c == 0xED) {
+			max = 0x9F;
+		}
+	} else if((c >= 0xF0) && (c <= 0xF4)) {
+		len = 4;
+		if(c == 0xF0) {
+			min = 0x90;
+		} else if(c == 0xF4) {
+			max = 0x8F;
+		}
+	} else {
+		return 0;
+	}
+	if(unlikely(static_cast<string::size_type>(str_end - str) < len)) {
+		return 0;
+	}
+	c = str[1];
+	if(unlikely((c < min) || (c > max))) {
+		return 0;
+	}
+	for(string::size_type i(2); i < len; ++i) {
+		c = str[i];
+		if(unlikely((c < 0x80) || (c > 0xBF))) {
+			return 0;
+		}
+	}
+	return len;
+}
+
+void PrintJsonl::append_string(string *dest, const string& s) {
+	dest->append(1, '\"');
+	const char *str(s.c_str());
+	const char *str_end(str + s.size());
+	const char *run(str);
+	for(; likely(str != str_end); ++str) {
+		unsigned char c(*str);
+		if(likely((c >= 0x20) && (c < 0x80) && (c != '\"') && (c != '\\'))) {
+			continue;
+		}
+		if(c >= 0x80) {
+			string::size_type len(utf8_length(str, str_end));
+			if(likely(len != 0)) {
+				str += len - 1;
+				continue;
+			}
+		}
+		// Copy the runs without special symbols in bulk
+		dest->append(run, str - run);
+		run = str + 1;
+		switch(c) {
+			case '\"':
+				dest->append("\\\"");
+				break;
+			case '\\':
+				dest->append("\\\\");
+				break;
+			case '\n':
+				dest->append("\\n");
+				break;
+			case '\t':
+				dest->append("\\t");
+				break;
+			default:
+				if(c >= 0x80) {
+					// Invalid UTF-8: Replace byte by byte by U+FFFD
+					dest->append("\\ufffd");
+				} else {
+					static CONSTEXPR const char hex[] = "0123456789abcdef";
+					dest->append("\\u00");
+					dest->append(1, hex[c >> 4]);
+					dest->append(1, hex[c & 0xF]);
+				}
+				break;
+		}
+	}
+	dest->append(run, str - run);
+	dest->append(1, '\"');
+}
+
+static void append_mask_flags(string *out, const char *key, MaskFlags mask) {
+	append_key(out, key);
+	out->append(1, '[');
+	bool first(true);
+	if(mask.isPackageMask()) {
+		append_word(out, &first, "MASK_PACKAGE");
+	}
+	if(mask.isSystem()) {
+		append_word(out, &first, "MASK_SYSTEM");
+	}
+	if(mask.isProfileMask()) {
+		append_word(out, &first, "MASK_PROFILE");
+	}
+	if(mask.isProfile()) {
+		append_word(out, &first, "IN_PROFILE");
+	}
+	if(mask.isWorld()) {
+		append_word(out, &first, "WORLD");
+	}
+	if(mask.isWorldSets()) {
+		append_word(out, &first, "WORLD_SETS");
+	}
+	if(mask.isMarked()) {
+		append_word(out, &first, "MARKED");
+	}
+	out->append(1, ']');
+}
+
+static void append_key_flags(string *out, const char *key, KeywordsFlags key_flags) {
+	append_key(out, key);
+	out->append(1, '[');
+	bool first(true);
+	if(key_flags.isStable()) {
+		append_word(out, &first, "STABLE");
+	}
+	if(key_flags.isArchStable()) {
+		append_word(out, &first, "ARCHSTABLE");
+	}
+	if(key_flags.isUnstable()) {
+		append_word(out, &first, "ARCHUNSTABLE");
+	}
+	if(key_flags.isAlienStable()) {
+		append_word(out, &first, "ALIENSTABLE");
+	}
+	if(key_flags.isAlienUnstable()) {
+		append_word(out, &first, "ALIENUNSTABLE");
+	}
+	if(key_flags.isMinusKeyword()) {
+		append_word(out, &first, "MINUSKEYWORD");
+	}
+	if(key_flags.isMinusUnstable()) {
+		append_word(out, &first, "MINUSUNSTABLE");
+	}
+	if(key_flags.isMinusAsterisk()) {
+		append_word(out, &first, "MINUSASTERISK");
+	}
+	out->append(1, ']');
+}
+
+static void append_restrictions(string *out, ExtendedVersion::Restrict restrict) {
+	append_key(out, "restrictions");
+	out->append(1, '[');
+	bool first(true);
+	if(unlikely((restrict & ExtendedVersion::RESTRICT_BINCHECKS) != 0)) {
+		append_word(out, &first, "BINCHECKS");
+	}
+	if(unlikely((restrict & ExtendedVersion::RESTRICT_STRIP) != 0)) {
+		append_word(out, &first, "STRIP");
+	}
+	if(unlikely((restrict & ExtendedVersion::RESTRICT_TEST) != 0)) {
+		append_word(out, &first, "TEST");
+	}
+	if(unlikely((restrict & ExtendedVersion::RESTRICT_USERPRIV) != 0)) {
+		append_word(out, &first, "USERPRIV");
+	}
+	if(unlikely((restrict & ExtendedVersion::RESTRICT_INSTALLSOURCES) != 0)) {
+		append_word(out, &first, "INSTALLSOURCES");
+	}
+	if(unlikely((restrict & ExtendedVersion::RESTRICT_FETCH) != 0)) {
+		append_word(out, &first, "FETCH");
+	}
+	if(unlikely((restrict & ExtendedVersion::RESTRICT_MIRROR) != 0)) {
+		append_word(out, &first, "MIRROR");
+	}
+	if(unlikely((restrict & ExtendedVersion::RESTRICT_PRIMARYURI) != 0)) {
+		append_word(out, &first, "PRIMARYURI");
+	}
+	if(unlikely((restrict & ExtendedVersion::RESTRICT_BINDIST) != 0)) {
+		append_word(out, &first, "BINDIST");
+	}
+	if(unlikely((restrict & ExtendedVersion::RESTRICT_PARALLEL) != 0)) {
+		append_word(out, &first, "PARALLEL");
+	}
+	out->append(1, ']');
+}
+
+static void append_properties(string *out, ExtendedVersion::Restrict props) {
+	append_key(out, "properties");
+	out->append(1, '[');
+	bool first(true);
+	if(unlikely((props & ExtendedVersion::PROPERTIES_INTERACTIVE) != 0)) {
+		append_word(out, &first, "INTERACTIVE");
+	}
+	if(unlikely((props & ExtendedVersion::PROPERTIES_LIVE) != 0)) {
+		append_word(out, &first, "LIVE");
+	}
+	if(unlikely((props & ExtendedVersion::PROPERTIES_VIRTUAL) != 0)) {
+		append_word(out, &first, "VIRTUAL");
+	}
+	if(unlikely((props & ExtendedVersion::PROPERTIES_SET) != 0)) {
+		append_word(out, &first, "SET");
+	}
+	out->append(1, ']');
+}
@@ -0,0 +1,58 @@
+// vim:set noet cinoptions= sw=4 ts=4:
+// This file is part of the eix project and distributed under the
+// terms of the GNU General Public License v2.
+//
+// Copyright (c)
+//   Martin Väth <martin@mvath.de>
+
+#ifndef SRC_OUTPUT_PRINT_JSONL_H_
+#define SRC_OUTPUT_PRINT_JSONL_H_ 1
+
+#include <config.h>  // IWYU pragma: keep
+
+#include <string>
+
+#include "eixTk/attribute.h"
+#include "eixTk/dialect.h"
+#include "eixTk/null.h"
+#include "output/print-formats.h"
+#include "portage/package.h"
+
+class DBHeader;
+class VarDbPkg;
+class PrintFormat;
+class SetStability;
+
+/**
+Output each package as a JSON object on a separate line (JSON Lines).
+The fields correspond to those of eix.proto
+**/
+class PrintJsonl FINAL : public PrintFormats {
+	protected:
+		const DBHeader *hdr;
+		VarDbPkg *var_db_pkg;
+		const PrintFormat *print_format;
+		const SetStability *stability;
+
+		/**
+		Scratch space reused for all packages: The output of a package
+		is collected in buffer and written at once
+		**/
+		std::string buffer;
+
+	public:
+		ATTRIBUTE_NONNULL_ PrintJsonl(const DBHeader *header, VarDbPkg *vardb, const PrintFormat *printformat, const SetStability *set_stability) :
+			hdr(header), var_db_pkg(vardb), print_format(printformat), stability(set_stability) {}
+
+		PrintJsonl() : hdr(NULLPTR), var_db_pkg(NULLPTR), print_format(NULLPTR), stability(NULLPTR) {}
+
+		ATTRIBUTE_NONNULL_ void package(Package *pkg) OVERRIDE;
+
+		/**
+		Append s as a quoted JSON string to dest;
+		invalid UTF-8 is replaced by U+FFFD
+		**/
+		ATTRIBUTE_NONNULL_ static void append_string(std::string *dest, const std::string& s);
+};
+
+#endif  // SRC_OUTPUT_PRINT_JSONL_H_
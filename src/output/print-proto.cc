@@ -8,27 +8,27 @@
 #include "output/print-proto.h"
 #include <config.h>  // IWYU pragma: keep
 
+#include <cstdlib>
+
 #ifdef WITH_PROTOBUF
+#include <cstdio>
+
 #include <iostream>
-#include <set>
 #include <string>
-#else
-#include <cstdlib>
 #endif
 
-#ifdef WITH_PROTOBUF
-#include "eixTk/dialect.h"
-#else
 #include "eixTk/formated.h"
 #include "eixTk/i18n.h"
-#endif
 
 #ifdef WITH_PROTOBUF
+#include <google/protobuf/arena.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/util/delimited_message_util.h>
+
 #include "eixTk/dialect.h"
 #include "eixTk/likely.h"
 #include "eixTk/null.h"
 #include "eixTk/stringtypes.h"
-#include "eixTk/unordered_set.h"
 WSUGGEST_FINAL_METHODS_OFF
 #include "output/eix.pb.h"
 WSUGGEST_FINAL_METHODS_ON
@@ -44,7 +44,6 @@ WSUGGEST_FINAL_METHODS_ON
 #include "portage/vardbpkg.h"
 #include "portage/version.h"
 
-using std::set;
 using std::string;
 
 static void set_mask_flags(eix_proto::MaskFlags *mask_flags, MaskFlags mask);
@@ -53,14 +52,35 @@ static void add_restrictions(eix_proto::Restrictions *restrictions, ExtendedVers
 static void add_properties(eix_proto::Properties *properties, ExtendedVersion::Restrict props);
 
 void PrintProto::start() {
+	if(delimited) {
+		arena = new google::protobuf::Arena();
+		return;
+	}
 	collection = new eix_proto::Collection();
 	category_index.clear();
 }
 
 void PrintProto::package(Package *pkg) {
-	if(collection == NULLPTR) {
+	if((collection == NULLPTR) && (arena == NULLPTR)) {
 		start();
 	}
+	if(delimited) {
+		eix_proto::Category *category(google::protobuf::Arena::CreateMessage<eix_proto::Category>(arena));
+		category->set_category(pkg->category);
+		fill_package(category->add_package(), pkg);
+		// Write through eix::write_output to exit when the reader has gone
+		string output;
+		{
+			google::protobuf::io::StringOutputStream stream(&output);
+			if(unlikely(!google::protobuf::util::SerializeDelimitedToZeroCopyStream(*category, &stream))) {
+				eix::say_error(_("cannot serialize category %s")) % pkg->category;
+				std::exit(EXIT_FAILURE);
+			}
+		}
+		eix::write_output(stdout, output);
+		arena->Reset();
+		return;
+	}
 	eix_proto::Category *category;
 	int& index = category_index[pkg->category];
 	if (index != 0) {
@@ -72,38 +92,17 @@ void PrintProto::package(Package *pkg) {
 		category->set_category(pkg->category);
 		index = collection->category_size();
 	}
-	eix_proto::Package *package = category->add_package();
+	fill_package(category->add_package(), pkg);
+}
+
+void PrintProto::fill_package(eix_proto::Package *package, Package *pkg) {
 	package->set_name(pkg->name);
 	package->set_description(pkg->desc);
 	package->set_homepage(pkg->homepage);
 	package->set_licenses(pkg->licenses);
 
-	UNORDERED_SET<const Version*> have_inst;
-	if((likely(var_db_pkg != NULLPTR)) && var_db_pkg->isInstalled(*pkg)) {
-		set<BasicVersion> know_inst;  // NOLINT(build/include_what_you_use)
-		// First we check which versions are installed with correct overlays.
-		if(likely(hdr != NULLPTR)) {
-			// Package is a 'list' of Versions with added members ^^
-			for(Package::const_iterator ver(pkg->begin());
-				likely(ver != pkg->end()); ++ver) {
-				if(var_db_pkg->isInstalledVersion(*pkg, *ver, *hdr) > 0) {
-					know_inst.INSERT(**ver);
-					have_inst.INSERT(*ver);
-				}
-			}
-		}
-		// From the remaining ones we choose the last.
-		// The following should actually be const_reverse_iterator,
-		// but some compilers would then need a cast of rend(),
-		// see https://bugs.gentoo.org/show_bug.cgi?id=354071
-		for(Package::reverse_iterator ver(pkg->rbegin());
-			likely(ver != pkg->rend()); ++ver) {
-			if(know_inst.count(**ver) == 0) {
-				know_inst.INSERT(**ver);
-				have_inst.INSERT(*ver);
-			}
-		}
-	}
+	VersionSet have_inst;
+	installed_versions(&have_inst, pkg, var_db_pkg, hdr);
 
 	for(Package::const_iterator ver(pkg->begin()); likely(ver != pkg->end()); ++ver) {
 		eix_proto::Version *version = package->add_version();
@@ -352,6 +351,10 @@ static void add_properties(eix_proto::Properties *properties, ExtendedVersion::R
 }
 
 void PrintProto::finish() {
+	if(arena != NULLPTR) {
+		delete arena;
+		arena = NULLPTR;
+	}
 	if(collection == NULLPTR) {
 		return;
 	}
@@ -26,6 +26,13 @@ class SetStability;
 
 namespace eix_proto {
 class Collection;
+class Package;
+}
+
+namespace google {
+namespace protobuf {
+class Arena;
+}
 }
 
 class PrintProto FINAL : public PrintFormats {
@@ -38,11 +45,21 @@ class PrintProto FINAL : public PrintFormats {
 		typedef UNORDERED_MAP<std::string, int> CategoryIndex;
 		CategoryIndex category_index;
 
+		/**
+		If true, each package is output immediately as a length-delimited
+		Category message (with only this package); the messages are
+		created in arena which is reset after each package
+		**/
+		bool delimited;
+		google::protobuf::Arena *arena;
+
+		ATTRIBUTE_NONNULL_ void fill_package(eix_proto::Package *package, Package *pkg);
+
 	public:
-		ATTRIBUTE_NONNULL_ PrintProto(const DBHeader *header, VarDbPkg *vardb, const PrintFormat *printformat, const SetStability *set_stability) :
-			hdr(header), var_db_pkg(vardb), print_format(printformat), stability(set_stability), collection(NULLPTR) {}
+		ATTRIBUTE_NONNULL_ PrintProto(const DBHeader *header, VarDbPkg *vardb, const PrintFormat *printformat, const SetStability *set_stability, bool stream) :
+			hdr(header), var_db_pkg(vardb), print_format(printformat), stability(set_stability), collection(NULLPTR), delimited(stream), arena(NULLPTR) {}
 
-		PrintProto() : hdr(NULLPTR), var_db_pkg(NULLPTR), print_format(NULLPTR), stability(NULLPTR), collection(NULLPTR) {}
+		PrintProto() : hdr(NULLPTR), var_db_pkg(NULLPTR), print_format(NULLPTR), stability(NULLPTR), collection(NULLPTR), delimited(false), arena(NULLPTR) {}
 
 		void start() OVERRIDE;
 
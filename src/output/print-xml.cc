@@ -9,17 +9,19 @@
 #include "output/print-xml.h"
 #include <config.h>  // IWYU pragma: keep
 
-#include <set>
+#include <cstdio>
+
 #include <string>
 
 #include "database/header.h"
+#include "eixTk/attribute.h"
 #include "eixTk/dialect.h"
 #include "eixTk/formated.h"
 #include "eixTk/likely.h"
 #include "eixTk/null.h"
 #include "eixTk/stringtypes.h"
+#include "eixTk/stringutils.h"
 #include "eixTk/sysutils.h"
-#include "eixTk/unordered_set.h"
 #include "eixrc/eixrc.h"
 #include "output/formatstring.h"
 #include "portage/basicversion.h"
@@ -33,12 +35,11 @@
 #include "portage/vardbpkg.h"
 #include "portage/version.h"
 
-using std::set;
 using std::string;
 
 const PrintXml::XmlVersion PrintXml::current;
 
-static void print_iuse(const IUseSet::IUseStd& s, IUse::Flags wanted, const char *dflt);
+ATTRIBUTE_NONNULL((1)) static void append_iuse(string *out, const IUseSet::IUseStd& s, IUse::Flags wanted, const char *dflt);
 
 void PrintXml::runclear() {
 	started = false;
@@ -98,73 +99,83 @@ void PrintXml::finish() {
 	runclear();
 }
 
-static void print_iuse(const IUseSet::IUseStd& s, IUse::Flags wanted, const char *dflt) {
+static void append_iuse(string *out, const IUseSet::IUseStd& s, IUse::Flags wanted, const char *dflt) {
 	bool have_found(false);
 	for(IUseSet::IUseStd::const_iterator it(s.begin()); likely(it != s.end()); ++it) {
 		if(((it->flags) & wanted) == 0) {
 			continue;
 		}
 		if(likely(have_found)) {
-			eix::print(" %s") % PrintXml::escape_xmlstring(false, it->name());
+			out->append(1, ' ');
+			PrintXml::append_escaped(out, false, it->name());
 			continue;
 		}
 		have_found = true;
 		if(dflt != NULLPTR) {
-			eix::print("\t\t\t\t<iuse default=\"%s\">") % dflt;
+			out->append("\t\t\t\t<iuse default=\"");
+			out->append(dflt);
+			out->append("\">");
 		} else {
-			eix::print("\t\t\t\t<iuse>");
+			out->append("\t\t\t\t<iuse>");
 		}
-		eix::print() % PrintXml::escape_xmlstring(false, it->name());
+		PrintXml::append_escaped(out, false, it->name());
 	}
 	if(have_found) {
-		eix::say("</iuse>");
+		out->append("</iuse>\n");
 	}
 }
 
+/**
+Append " name=\"value\"" with value escaped
+**/
+ATTRIBUTE_NONNULL_ inline static void append_attribute(string *out, const char *name, const string& value);
+inline static void append_attribute(string *out, const char *name, const string& value) {
+	out->append(1, ' ');
+	out->append(name);
+	out->append("=\"");
+	PrintXml::append_escaped(out, true, value);
+	out->append(1, '\"');
+}
+
+/**
+Append "<name>content</name>" with content escaped (content must be nonempty)
+**/
+ATTRIBUTE_NONNULL_ inline static void append_text_element(string *out, const char *name, const string& content);
+inline static void append_text_element(string *out, const char *name, const string& content) {
+	out->append("\t\t\t\t<");
+	out->append(name);
+	out->append(1, '>');
+	PrintXml::append_escaped(out, false, content);
+	out->append("</");
+	out->append(name);
+	out->append(">\n");
+}
+
 void PrintXml::package(Package *pkg) {
 	if(unlikely(!started)) {
 		start();
 	}
+	string *out(&buffer);
+	out->clear();
 	if(unlikely(curcat != pkg->category)) {
 		if(!curcat.empty()) {
-			eix::say("\t</category>");
+			out->append("\t</category>\n");
 		}
 		curcat = pkg->category;
-		eix::say("\t<category name=\"%s\">") % escape_xmlstring(true, curcat);
+		out->append("\t<category");
+		append_attribute(out, "name", curcat);
+		out->append(">\n");
 	}
 	// category, name, desc, homepage, licenses;
-	eix::say("\t\t<package name=\"%s\">")
-		% escape_xmlstring(true, pkg->name);
-	say_xml_element("\t\t\t", "description", pkg->desc);
-	say_xml_element("\t\t\t", "homepage", pkg->homepage);
-	say_xml_element("\t\t\t", "licenses", pkg->licenses);
-
-	UNORDERED_SET<const Version*> have_inst;
-	if((likely(var_db_pkg != NULLPTR)) && var_db_pkg->isInstalled(*pkg)) {
-		set<BasicVersion> know_inst;
-		// First we check which versions are installed with correct overlays.
-		if(likely(hdr != NULLPTR)) {
-			// Package is a 'list' of Versions with added members ^^
-			for(Package::const_iterator ver(pkg->begin());
-				likely(ver != pkg->end()); ++ver) {
-				if(var_db_pkg->isInstalledVersion(*pkg, *ver, *hdr) > 0) {
-					know_inst.INSERT(**ver);
-					have_inst.INSERT(*ver);
-				}
-			}
-		}
-		// From the remaining ones we choose the last.
-		// The following should actually be const_reverse_iterator,
-		// but some compilers would then need a cast of rend(),
-		// see https://bugs.gentoo.org/show_bug.cgi?id=354071
-		for(Package::reverse_iterator ver(pkg->rbegin());
-			likely(ver != pkg->rend()); ++ver) {
-			if(know_inst.count(**ver) == 0) {
-				know_inst.INSERT(**ver);
-				have_inst.INSERT(*ver);
-			}
-		}
-	}
+	out->append("\t\t<package");
+	append_attribute(out, "name", pkg->name);
+	out->append(">\n");
+	append_xml_element(out, "\t\t\t", "description", pkg->desc);
+	append_xml_element(out, "\t\t\t", "homepage", pkg->homepage);
+	append_xml_element(out, "\t\t\t", "licenses", pkg->licenses);
+
+	VersionSet have_inst;
+	installed_versions(&have_inst, pkg, var_db_pkg, hdr);
 
 	for(Package::const_iterator ver(pkg->begin()); likely(ver != pkg->end()); ++ver) {
 		bool versionInstalled(false);
@@ -177,38 +188,34 @@ void PrintXml::package(Package *pkg) {
 			}
 		}
 
-		eix::print("\t\t\t<version id=\"%s\" EAPI=\"%s\"")
-			% escape_xmlstring(true, ver->getFull())
-			% escape_xmlstring(true, ver->eapi.get());
+		out->append("\t\t\t<version");
+		append_attribute(out, "id", ver->getFull());
+		append_attribute(out, "EAPI", ver->eapi.get());
 		ExtendedVersion::Overlay overlay_key(ver->overlay_key);
 		if(unlikely(overlay_key != 0)) {
 			if(print_format->is_virtual(overlay_key)) {
-				eix::print(" virtual=\"1\"");
+				out->append(" virtual=\"1\"");
 			}
 			const OverlayIdent& overlay(hdr->getOverlay(overlay_key));
 			if((print_overlay || overlay.label.empty()) && !(overlay.path.empty())) {
-				eix::print(" overlay=\"%s\"")
-					% escape_xmlstring(true, overlay.path);
+				append_attribute(out, "overlay", overlay.path);
 			}
 			if(!overlay.label.empty()) {
-				eix::print(" repository=\"%s\"")
-					% escape_xmlstring(true, overlay.label);
+				append_attribute(out, "repository", overlay.label);
 			}
 		}
 		if(!ver->get_shortfullslot().empty()) {
-			eix::print(" slot=\"%s\"")
-				% escape_xmlstring(true, ver->get_longfullslot());
+			append_attribute(out, "slot", ver->get_longfullslot());
 		}
 		if(!ver->src_uri.empty()) {
-			eix::print(" srcURI=\"%s\"")
-				% escape_xmlstring(true, ver->src_uri);
+			append_attribute(out, "srcURI", ver->src_uri);
 		}
 		if(versionInstalled) {
-			eix::print(" installed=\"1\" installDate=\"%s\" installEAPI=\"%s\"")
-				% escape_xmlstring(true, date_conv(dateformat.c_str(), installedVersion->instDate))
-				% escape_xmlstring(true, installedVersion->eapi.get());
+			out->append(" installed=\"1\"");
+			append_attribute(out, "installDate", date_conv(dateformat.c_str(), installedVersion->instDate));
+			append_attribute(out, "installEAPI", installedVersion->eapi.get());
 		}
-		eix::say('>');
+		out->append(">\n");
 
 		MaskFlags currmask(ver->maskflags);
 		KeywordsFlags currkey(ver->keyflags);
@@ -216,69 +223,70 @@ void PrintXml::package(Package *pkg) {
 		KeywordsFlags waskey;
 		stability->calc_version_flags(false, &wasmask, &waskey, *ver, pkg);
 
-		WordVec mask_text, unmask_text;
-		// The following might give a memory leak with -flto for unknown reasons:
-		// mask_text.PUSH_BACK("FOO") or mask_text.PUSH_BACK("BAR")
+		mask_text.clear();
+		unmask_text.clear();
 		if(wasmask.isHardMasked()) {
 			if(currmask.isProfileMask()) {
-				mask_text.push_back("profile");
+				mask_text.PUSH_BACK("profile");
 			} else if(currmask.isPackageMask()) {
-				mask_text.push_back("hard");
+				mask_text.PUSH_BACK("hard");
 			} else if(wasmask.isProfileMask()) {
-				mask_text.push_back("profile");
-				unmask_text.push_back("package_unmask");
+				mask_text.PUSH_BACK("profile");
+				unmask_text.PUSH_BACK("package_unmask");
 			} else {
-				mask_text.push_back("hard");
-				unmask_text.push_back("package_unmask");
+				mask_text.PUSH_BACK("hard");
+				unmask_text.PUSH_BACK("package_unmask");
 			}
 		} else if(currmask.isHardMasked()) {
-			mask_text.push_back("package_mask");
+			mask_text.PUSH_BACK("package_mask");
 		}
 
 		if(currkey.isStable()) {
 			if(waskey.isStable()) {
 				//
 			} else if(waskey.isUnstable()) {
-				mask_text.push_back("keyword");
-				unmask_text.push_back("package_keywords");
+				mask_text.PUSH_BACK("keyword");
+				unmask_text.PUSH_BACK("package_keywords");
 			} else if(waskey.isMinusKeyword()) {
-				mask_text.push_back("minus_keyword");
-				unmask_text.push_back("package_keywords");
+				mask_text.PUSH_BACK("minus_keyword");
+				unmask_text.PUSH_BACK("package_keywords");
 			} else if(waskey.isAlienStable()) {
-				mask_text.push_back("alien_stable");
-				unmask_text.push_back("package_keywords");
+				mask_text.PUSH_BACK("alien_stable");
+				unmask_text.PUSH_BACK("package_keywords");
 			} else if(waskey.isAlienUnstable()) {
-				mask_text.push_back("alien_unstable");
-				unmask_text.push_back("package_keywords");
+				mask_text.PUSH_BACK("alien_unstable");
+				unmask_text.PUSH_BACK("package_keywords");
 			} else if(waskey.isMinusUnstable()) {
-				mask_text.push_back("minus_unstable");
-				unmask_text.push_back("package_keywords");
+				mask_text.PUSH_BACK("minus_unstable");
+				unmask_text.PUSH_BACK("package_keywords");
 			} else if(waskey.isMinusAsterisk()) {
-				mask_text.push_back("minus_asterisk");
-				unmask_text.push_back("package_keywords");
+				mask_text.PUSH_BACK("minus_asterisk");
+				unmask_text.PUSH_BACK("package_keywords");
 			} else {
-				mask_text.push_back("missing_keyword");
-				unmask_text.push_back("package_keywords");
+				mask_text.PUSH_BACK("missing_keyword");
+				unmask_text.PUSH_BACK("package_keywords");
 			}
 		} else if(currkey.isUnstable()) {
-			mask_text.push_back("keyword");
+			mask_text.PUSH_BACK("keyword");
 		} else if(currkey.isMinusKeyword()) {
-			mask_text.push_back("minus_keyword");
+			mask_text.PUSH_BACK("minus_keyword");
 		} else if(currkey.isAlienStable()) {
-			mask_text.push_back("alien_stable");
+			mask_text.PUSH_BACK("alien_stable");
 		} else if(currkey.isAlienUnstable()) {
-			mask_text.push_back("alien_unstable");
+			mask_text.PUSH_BACK("alien_unstable");
 		} else if(currkey.isMinusUnstable()) {
-			mask_text.push_back("minus_unstable");
+			mask_text.PUSH_BACK("minus_unstable");
 		} else if(currkey.isMinusAsterisk()) {
-			mask_text.push_back("minus_asterisk");
+			mask_text.PUSH_BACK("minus_asterisk");
 		} else {
-			mask_text.push_back("missing_keyword");
+			mask_text.PUSH_BACK("missing_keyword");
 		}
 
-		for(WordVec::const_iterator it(mask_text.begin());
+		for(TextList::const_iterator it(mask_text.begin());
 			unlikely(it != mask_text.end()); ++it) {
-			eix::say("\t\t\t\t<mask type=\"%s\"/>") % (*it);
+			out->append("\t\t\t\t<mask type=\"");
+			out->append(*it);
+			out->append("\"/>\n");
 		}
 
 		if(unlikely(ver->have_reasons())) {
@@ -289,44 +297,46 @@ void PrintXml::package(Package *pkg) {
 				if((vec == NULLPTR) || (vec->empty())) {
 					continue;
 				}
-				eix::print("\t\t\t\t<maskreason>");
+				out->append("\t\t\t\t<maskreason>");
 				bool pret(false);
 				for(WordVec::const_iterator wit(vec->begin());
 					likely(wit != vec->end()); ++wit) {
 					if(likely(pret)) {
-						eix::say_empty();
+						out->append(1, '\n');
 					} else {
 						pret = true;
 					}
-					eix::say() % escape_xmlstring(false, *wit);
+					append_escaped(out, false, *wit);
+					out->append(1, '\n');
 				}
-				eix::say("</maskreason>");
+				out->append("</maskreason>\n");
 			}
 		}
 
-		for(WordVec::const_iterator it(unmask_text.begin());
+		for(TextList::const_iterator it(unmask_text.begin());
 			unlikely(it != unmask_text.end()); ++it) {
-			eix::say("\t\t\t\t<unmask type=\"%s\"/>") % (*it);
+			out->append("\t\t\t\t<unmask type=\"");
+			out->append(*it);
+			out->append("\"/>\n");
 		}
 
 		if(!(ver->iuse.empty())) {
 			const IUseSet::IUseStd& s(ver->iuse.asStd());
-			print_iuse(s, IUse::USEFLAGS_NORMAL, NULLPTR);
-			print_iuse(s, IUse::USEFLAGS_PLUS, "1");
-			print_iuse(s, IUse::USEFLAGS_MINUS, "-1");
+			append_iuse(out, s, IUse::USEFLAGS_NORMAL, NULLPTR);
+			append_iuse(out, s, IUse::USEFLAGS_PLUS, "1");
+			append_iuse(out, s, IUse::USEFLAGS_MINUS, "-1");
 		}
 		if(Version::use_required_use) {
-			string &required_use(ver->required_use);
+			const string& required_use(ver->required_use);
 			if(!(required_use.empty())) {
-				eix::say("\t\t\t\t<required_use>%s</required_use>")
-					% escape_xmlstring(false, required_use);
+				append_text_element(out, "required_use", required_use);
 			}
 		}
 		if(versionInstalled) {
 			string iuse_disabled, iuse_enabled;
 			var_db_pkg->readUse(*pkg, installedVersion);
-			WordVec inst_iuse(installedVersion->inst_iuse);
-			WordSet usedUse(installedVersion->usedUse);
+			const WordVec& inst_iuse(installedVersion->inst_iuse);
+			const WordSet& usedUse(installedVersion->usedUse);
 			for(WordVec::const_iterator iu(inst_iuse.begin()); likely(iu != inst_iuse.end()); iu++) {
 				if(usedUse.count(*iu) == 0) {
 					if(!iuse_disabled.empty()) {
@@ -341,61 +351,63 @@ void PrintXml::package(Package *pkg) {
 				}
 			}
 			if(!iuse_disabled.empty()) {
-				eix::say("\t\t\t\t<use enabled=\"0\">%s</use>")
-					% escape_xmlstring(false, iuse_disabled);
+				out->append("\t\t\t\t<use enabled=\"0\">");
+				append_escaped(out, false, iuse_disabled);
+				out->append("</use>\n");
 			}
 			if(!iuse_enabled.empty()) {
-				eix::say("\t\t\t\t<use enabled=\"1\">%s</use>")
-					% escape_xmlstring(false, iuse_enabled);
+				out->append("\t\t\t\t<use enabled=\"1\">");
+				append_escaped(out, false, iuse_enabled);
+				out->append("</use>\n");
 			}
 		}
 
 		ExtendedVersion::Restrict restrict(ver->restrictFlags);
 		if(unlikely(restrict != ExtendedVersion::RESTRICT_NONE)) {
 			if(unlikely((restrict & ExtendedVersion::RESTRICT_BINCHECKS) != 0)) {
-				eix::say("\t\t\t\t<restrict flag=\"binchecks\"/>");
+				out->append("\t\t\t\t<restrict flag=\"binchecks\"/>\n");
 			}
 			if(unlikely((restrict & ExtendedVersion::RESTRICT_STRIP) != 0)) {
-				eix::say("\t\t\t\t<restrict flag=\"strip\"/>");
+				out->append("\t\t\t\t<restrict flag=\"strip\"/>\n");
 			}
 			if(unlikely((restrict & ExtendedVersion::RESTRICT_TEST) != 0)) {
-				eix::say("\t\t\t\t<restrict flag=\"test\"/>");
+				out->append("\t\t\t\t<restrict flag=\"test\"/>\n");
 			}
 			if(unlikely((restrict & ExtendedVersion::RESTRICT_USERPRIV) != 0)) {
-				eix::say("\t\t\t\t<restrict flag=\"userpriv\"/>");
+				out->append("\t\t\t\t<restrict flag=\"userpriv\"/>\n");
 			}
 			if(unlikely((restrict & ExtendedVersion::RESTRICT_INSTALLSOURCES) != 0)) {
-				eix::say("\t\t\t\t<restrict flag=\"installsources\"/>");
+				out->append("\t\t\t\t<restrict flag=\"installsources\"/>\n");
 			}
 			if(unlikely((restrict & ExtendedVersion::RESTRICT_FETCH) != 0)) {
-				eix::say("\t\t\t\t<restrict flag=\"fetch\"/>");
+				out->append("\t\t\t\t<restrict flag=\"fetch\"/>\n");
 			}
 			if(unlikely((restrict & ExtendedVersion::RESTRICT_MIRROR) != 0)) {
-				eix::say("\t\t\t\t<restrict flag=\"mirror\"/>");
+				out->append("\t\t\t\t<restrict flag=\"mirror\"/>\n");
 			}
 			if(unlikely((restrict & ExtendedVersion::RESTRICT_PRIMARYURI) != 0)) {
-				eix::say("\t\t\t\t<restrict flag=\"primaryuri\"/>");
+				out->append("\t\t\t\t<restrict flag=\"primaryuri\"/>\n");
 			}
 			if(unlikely((restrict & ExtendedVersion::RESTRICT_BINDIST) != 0)) {
-				eix::say("\t\t\t\t<restrict flag=\"bindist\"/>");
+				out->append("\t\t\t\t<restrict flag=\"bindist\"/>\n");
 			}
 			if(unlikely((restrict & ExtendedVersion::RESTRICT_PARALLEL) != 0)) {
-				eix::say("\t\t\t\t<restrict flag=\"parallel\"/>");
+				out->append("\t\t\t\t<restrict flag=\"parallel\"/>\n");
 			}
 		}
 		ExtendedVersion::Restrict properties(ver->propertiesFlags);
 		if(unlikely(properties != ExtendedVersion::PROPERTIES_NONE)) {
 			if(unlikely((properties & ExtendedVersion::PROPERTIES_INTERACTIVE) != 0)) {
-				eix::say("\t\t\t\t<properties flag=\"interactive\"/>");
+				out->append("\t\t\t\t<properties flag=\"interactive\"/>\n");
 			}
 			if(unlikely((properties & ExtendedVersion::PROPERTIES_LIVE) != 0)) {
-				eix::say("\t\t\t\t<properties flag=\"live\"/>");
+				out->append("\t\t\t\t<properties flag=\"live\"/>\n");
 			}
 			if(unlikely((properties & ExtendedVersion::PROPERTIES_VIRTUAL) != 0)) {
-				eix::say("\t\t\t\t<properties flag=\"virtual\"/>");
+				out->append("\t\t\t\t<properties flag=\"virtual\"/>\n");
 			}
 			if(unlikely((properties & ExtendedVersion::PROPERTIES_SET) != 0)) {
-				eix::say("\t\t\t\t<properties flag=\"set\"/>");
+				out->append("\t\t\t\t<properties flag=\"set\"/>\n");
 			}
 		}
 
@@ -419,87 +431,80 @@ void PrintXml::package(Package *pkg) {
 				}
 			}
 			if(print_full) {
-				say_xml_element("\t\t\t\t", "keywords", full_kw);
+				append_xml_element(out, "\t\t\t\t", "keywords", full_kw);
 			}
 			if(print_effective) {
-				say_xml_element("\t\t\t\t", "effective_keywords", eff_kw);
+				append_xml_element(out, "\t\t\t\t", "effective_keywords", eff_kw);
 			}
 		}
 
 		if(Depend::use_depend) {
 			const string& depend = ver->depend.get_depend();
 			if(!depend.empty()) {
-				eix::say("\t\t\t\t<depend>%s</depend>")
-					% escape_xmlstring(false, depend);
+				append_text_element(out, "depend", depend);
 			}
 			const string& rdepend = ver->depend.get_rdepend();
 			if(!rdepend.empty()) {
-				eix::say("\t\t\t\t<rdepend>%s</rdepend>")
-					% escape_xmlstring(false, rdepend);
+				append_text_element(out, "rdepend", rdepend);
 			}
 			const string& pdepend = ver->depend.get_pdepend();
 			if(!pdepend.empty()) {
-				eix::say("\t\t\t\t<pdepend>%s</pdepend>")
-					% escape_xmlstring(false, pdepend);
+				append_text_element(out, "pdepend", pdepend);
 			}
 			const string& bdepend = ver->depend.get_bdepend();
 			if(!bdepend.empty()) {
-				eix::say("\t\t\t\t<bdepend>%s</bdepend>")
-					% escape_xmlstring(false, bdepend);
+				append_text_element(out, "bdepend", bdepend);
 			}
 		}
-		eix::say("\t\t\t</version>");
+		out->append("\t\t\t</version>\n");
 	}
-	eix::say("\t\t</package>");
+	out->append("\t\t</package>\n");
+	eix::write_output(stdout, *out);
 	++count;
 }  // NOLINT(readability/fn_size)
 
-string PrintXml::escape_xmlstring(bool quoted, const string& s) {
-	string ret;
-	string::size_type prev(0);
-	string::size_type len(s.length());
-	for(string::size_type i(0); likely(i < len); ++i) {
-		const char *replace;
-		switch(s[i]) {
+void PrintXml::append_escaped(string *dest, bool quoted, const string& s) {
+	const char *str(s.c_str());
+	const char *str_end(str + s.size());
+	for(;;) {
+		// Copy the runs without special symbols in bulk
+		const char *special(find_first_of_range(str, str_end, "&<>'\"", (quoted ? 5 : 3)));
+		dest->append(str, special - str);
+		if(likely(special == str_end)) {
+			return;
+		}
+		switch(*special) {
 			case '&':
-				replace = "&amp;";
+				dest->append("&amp;");
 				break;
 			case '<':
-				replace = "&lt;";
+				dest->append("&lt;");
 				break;
 			case '>':
-				replace = "&gt;";
+				dest->append("&gt;");
 				break;
 			case '\'':
-				replace = (quoted ? "&apos;" : NULLPTR);
+				dest->append("&apos;");
 				break;
-			case '\"':
-				replace = (quoted ? "&quot;" : NULLPTR);
+			default:  // case '\"':
+				dest->append("&quot;");
 				break;
-			default:
-				replace = NULLPTR;
-				break;
-		}
-		if(unlikely(replace != NULLPTR)) {
-			ret.append(s, prev, i - prev);
-			ret.append(replace);
-			prev = i + 1;
 		}
+		str = special + 1;
 	}
-	if(likely(prev == 0)) {
-		return s;
-	}
-	if(prev < len) {
-		ret.append(s, prev, len - prev);
-	}
-	return ret;
 }
 
-void PrintXml::say_xml_element(const string& prefix, const string& name, const string& content) {
+void PrintXml::append_xml_element(string *out, const char *prefix, const char *name, const string& content) {
+	out->append(prefix);
+	out->append(1, '<');
+	out->append(name);
 	if(unlikely(content.empty())) {
-		eix::say("%s<%s/>") % prefix % name;
+		out->append("/>\n");
 		return;
 	}
-	eix::say("%s<%s>%s</%2$s>") % prefix % name
-		% escape_xmlstring(false, content);
+	out->append(1, '>');
+	append_escaped(out, false, content);
+	out->append("</");
+	out->append(name);
+	out->append(">\n");
 }
@@ -45,6 +45,14 @@ class PrintXml FINAL : public PrintFormats {
 		PackageList::size_type count;
 		std::string curcat;
 
+		/**
+		Scratch space reused for all packages: The output of a package
+		is collected in buffer and written at once
+		**/
+		std::string buffer;
+		typedef std::vector<const char *> TextList;
+		TextList mask_text, unmask_text;
+
 		void clear(EixRc *eixrc);
 		void runclear();
 
@@ -72,8 +80,14 @@ class PrintXml FINAL : public PrintFormats {
 		void start() OVERRIDE;
 		ATTRIBUTE_NONNULL_ void package(Package *pkg) OVERRIDE;
 		void finish() OVERRIDE;
-		static std::string escape_xmlstring(bool quoted, const std::string& s);
-		static void say_xml_element(const std::string& prefix, const std::string& name, const std::string& content);
+
+		/**
+		Append s to dest, escaping the XML special symbols;
+		' and " are only escaped if quoted is true
+		**/
+		ATTRIBUTE_NONNULL_ static void append_escaped(std::string *dest, bool quoted, const std::string& s);
+
+		ATTRIBUTE_NONNULL_ static void append_xml_element(std::string *out, const char *prefix, const char *name, const std::string& content);
 
 		~PrintXml() {
 			finish();
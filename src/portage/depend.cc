@@ -8,10 +8,16 @@
 #include "portage/depend.h"
 #include <config.h>  // IWYU pragma: keep
 
+#include <cstring>
+
 #include <string>
 
+#include "eixTk/attribute.h"
+#include "eixTk/diagnostics.h"
 #include "eixTk/dialect.h"
 #include "eixTk/likely.h"
+#include "eixTk/null.h"
+#include "eixTk/stringtypes.h"
 #include "eixTk/stringutils.h"
 
 using std::string;
@@ -67,11 +73,21 @@ void Depend::set(const string& depend, const string& rdepend, const string& pdep
 }
 
 string Depend::subst(const string& in, const string& text, bool obs) {
+	if(in.find(the_same) == string::npos) {
+		return in;
+	}
+	string ret;
+	subst(&ret, in, text, obs);
+	return ret;
+}
+
+const char *Depend::subst(string *buffer, const string& in, const string& text, bool obs) {
 	string::size_type pos(in.find(the_same));
 	if(pos == string::npos) {
-		return in;
+		return in.c_str();
 	}
-	string ret(in);
+	string& ret(*buffer);
+	ret.assign(in);
 	if(unlikely(obs) && ((pos + 1) != ret.size())) {
 		ret[pos] = ' ';
 		if(pos > 0) {
@@ -83,7 +99,61 @@ string Depend::subst(const string& in, const string& text, bool obs) {
 		ret.erase(pos, 1);
 	}
 	ret.insert(pos, text);
-	return ret;
+	return ret.c_str();
+}
+
+bool Depend::atom_package(string *package, const char *atom) {
+	// Skip blockers and operators
+	while(*atom == '!') {
+		++atom;
+	}
+	bool have_operator(false);
+	while((*atom == '<') || (*atom == '>') || (*atom == '=') || (*atom == '~')) {
+		++atom;
+		have_operator = true;
+	}
+	// The category must not be empty, and the name must follow
+	const char *slash(std::strchr(atom, '/'));
+	if((slash == NULLPTR) || (slash == atom) || (slash[1] == '\0')) {
+		return false;
+	}
+	const char *end(NULLPTR);
+	if(have_operator) {
+		end = ExplodeAtom::get_start_of_version(slash + 1, true);
+		if(end != NULLPTR) {
+			--end;  // the '-' before the version
+		}
+	}
+	if(end == NULLPTR) {
+		end = slash + 1 + std::strcspn(slash + 1, ":[");
+	}
+	if(unlikely(end <= slash + 1)) {
+		return false;
+	}
+GCC_DIAG_OFF(sign-conversion)
+	package->assign(atom, end - atom);
+GCC_DIAG_ON(sign-conversion)
+	return true;
+}
+
+ATTRIBUTE_NONNULL_ static void add_atom_packages(WordSet *packages, const string& dep);
+static void add_atom_packages(WordSet *packages, const string& dep) {
+	WordVec words;
+	split_string(&words, dep);
+	string package;
+	for(WordVec::const_iterator it(words.begin()); likely(it != words.end()); ++it) {
+		if(Depend::atom_package(&package, it->c_str())) {
+			packages->INSERT(package);
+		}
+	}
+}
+
+void Depend::add_packages(WordSet *packages) const {
+	// A "the same" symbol is not an atom, and its content is scanned anyway
+	add_atom_packages(packages, m_depend);
+	add_atom_packages(packages, m_rdepend);
+	add_atom_packages(packages, m_pdepend);
+	add_atom_packages(packages, m_bdepend);
 }
 
 bool Depend::operator==(const Depend& d) const {
@@ -12,6 +12,9 @@
 
 #include <string>
 
+#include "eixTk/attribute.h"
+#include "eixTk/stringtypes.h"
+
 class Database;
 class DBHeader;
 class Version;
@@ -29,6 +32,12 @@ class Depend {
 
 		static std::string subst(const std::string& in, const std::string& text, bool obs);
 
+		/**
+		As subst(in, text, obs), but buffer is only used if substitution
+		is needed; in particular, usually no new string is created
+		**/
+		ATTRIBUTE_NONNULL_ static const char *subst(std::string *buffer, const std::string& in, const std::string& text, bool obs);
+
 	public:
 		static bool use_depend;
 
@@ -41,6 +50,26 @@ class Depend {
 			return subst(m_depend, m_rdepend, obsolete);
 		}
 
+		/**
+		The get_*depend(buffer) variants avoid creating new strings;
+		the result is valid until buffer or this is modified
+		**/
+		ATTRIBUTE_NONNULL_ const char *get_depend(std::string *buffer) const {
+			return subst(buffer, m_depend, m_rdepend, obsolete);
+		}
+
+		ATTRIBUTE_NONNULL_ const char *get_rdepend(std::string *buffer) const {
+			return subst(buffer, m_rdepend, m_depend, obsolete);
+		}
+
+		ATTRIBUTE_NONNULL_ const char *get_pdepend(std::string * /* buffer */) const {
+			return m_pdepend.c_str();
+		}
+
+		ATTRIBUTE_NONNULL_ const char *get_bdepend(std::string * /* buffer */) const {
+			return m_bdepend.c_str();
+		}
+
 		std::string get_depend_brief() const {
 			return subst(m_depend, c_rdepend, obsolete);
 		}
@@ -97,6 +126,18 @@ class Depend {
 			obsolete = false;
 		}
 
+		/**
+		Get category/name of the package of a dependency atom like
+		!!>=cat/name-1.0:2[use]
+		@return false if atom is not a package atom
+		**/
+		ATTRIBUTE_NONNULL_ static bool atom_package(std::string *package, const char *atom);
+
+		/**
+		Add category/name of all packages occurring in the dependencies
+		**/
+		ATTRIBUTE_NONNULL_ void add_packages(WordSet *packages) const;
+
 		bool operator==(const Depend& d) const;
 
 		bool operator!=(const Depend& d) const {
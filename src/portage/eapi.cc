@@ -44,7 +44,7 @@ void Eapi::assign(const std::string& str) {
 	eapi_vec->PUSH_BACK(str);
 }
 
-string Eapi::get() const {
+const string& Eapi::get() const {
 	eix_assert_static(eapi_vec != NULLPTR);
 	return (*eapi_vec)[eapi_index];
 }
@@ -12,6 +12,7 @@
 
 #include <string>
 
+#include "eixTk/attribute.h"
 #include "eixTk/inttypes.h"
 
 class Eapi {
@@ -29,7 +30,7 @@ class Eapi {
 
 		void assign(const std::string& str);
 
-		std::string get() const;
+		ATTRIBUTE_PURE const std::string& get() const;
 };
 
 #endif  // SRC_PORTAGE_EAPI_H_
@@ -55,6 +55,20 @@ string ExtendedVersion::get_longfullslot() const {
 		(slotname.empty() ? (string("0/") + subslotname) : (slotname + "/" + subslotname)));
 }
 
+const char *ExtendedVersion::get_longfullslot(string *buffer) const {
+	if(subslotname.empty()) {
+		return get_longslot_c_str();
+	}
+	if(slotname.empty()) {
+		buffer->assign(1, '0');
+	} else {
+		buffer->assign(slotname);
+	}
+	buffer->append(1, '/');
+	buffer->append(subslotname);
+	return buffer->c_str();
+}
+
 eix::SignedBool ExtendedVersion::compare(const ExtendedVersion& left, const ExtendedVersion& right) {
 	eix::SignedBool r(BasicVersion::compare(left, right));
 	if(likely(r != 0)) {
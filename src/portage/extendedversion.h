@@ -134,10 +134,20 @@ class ExtendedVersion : public BasicVersion {
 
 		std::string get_longfullslot() const;
 
+		/**
+		As get_longfullslot(), but without creating a new string:
+		buffer is used only if needed
+		**/
+		ATTRIBUTE_NONNULL_ const char *get_longfullslot(std::string *buffer) const;
+
 		std::string get_longslot() const {
 			return (slotname.empty() ? "0" : slotname);
 		}
 
+		const char *get_longslot_c_str() const {
+			return (slotname.empty() ? "0" : slotname.c_str());
+		}
+
 		void assign_basic_version(const BasicVersion& b) {
 			*static_cast<BasicVersion *>(this) = b;
 		}
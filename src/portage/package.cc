@@ -34,6 +34,65 @@ const Package::Versioncollects
 	Package::COLLECT_HAVE_MAIN_REPO_KEY,
 	Package::COLLECT_DEFAULT;
 
+const Package::DBFlags
+	Package::DBFLAGS_NONE,
+	Package::DBFLAGS_NONTRIVIAL_SLOTS,
+	Package::DBFLAGS_MULTI_SLOT,
+	Package::DBFLAGS_OVERLAY,
+	Package::DBFLAGS_DUP_PACKAGES,
+	Package::DBFLAGS_DUP_PACKAGES_OVERLAY,
+	Package::DBFLAGS_DUP_VERSIONS,
+	Package::DBFLAGS_DUP_VERSIONS_OVERLAY,
+	Package::DBFLAGS_STABLE,
+	Package::DBFLAGS_TESTING,
+	Package::DBFLAGS_NONMASKED,
+	Package::DBFLAGS_SYSTEM,
+	Package::DBFLAGS_PROFILE,
+	Package::DBFLAGS_ALL;
+
+Package::DBFlags Package::dbflags() const {
+	DBFlags ret(DBFLAGS_NONE);
+	if(have_nontrivial_slots()) {
+		ret |= DBFLAGS_NONTRIVIAL_SLOTS;
+	}
+	if(slotlist().size() > 1) {
+		ret |= DBFLAGS_MULTI_SLOT;
+	}
+	if(largest_overlay != 0) {
+		ret |= DBFLAGS_OVERLAY;
+	}
+	if(!have_same_overlay_key()) {
+		ret |= DBFLAGS_DUP_PACKAGES;
+	}
+	if(at_least_two_overlays()) {
+		ret |= DBFLAGS_DUP_PACKAGES_OVERLAY;
+	}
+	if((have_duplicate_versions & DUP_SOME) == DUP_SOME) {
+		ret |= DBFLAGS_DUP_VERSIONS;
+	}
+	if((have_duplicate_versions & DUP_OVERLAYS) == DUP_OVERLAYS) {
+		ret |= DBFLAGS_DUP_VERSIONS_OVERLAY;
+	}
+	for(const_iterator it(begin()); likely(it != end()); ++it) {
+		if(it->maskflags.isSystem()) {
+			ret |= DBFLAGS_SYSTEM;
+		}
+		if(it->maskflags.isProfile()) {
+			ret |= DBFLAGS_PROFILE;
+		}
+		if(it->maskflags.isHardMasked()) {
+			continue;
+		}
+		ret |= DBFLAGS_NONMASKED;
+		if(it->keyflags.isStable()) {
+			ret |= (DBFLAGS_STABLE | DBFLAGS_TESTING);
+		} else if(it->keyflags.isUnstable()) {
+			ret |= DBFLAGS_TESTING;
+		}
+	}
+	return ret;
+}
+
 void Package::defaults() {
 	know_upgrade_slots = m_has_cached_slotlist =
 		m_has_cached_subslots = false;
@@ -199,6 +199,31 @@ class Package : public eix::ptr_container<std::list<Version *> > {
 			return local_collects.isWorldSets();
 		}
 
+		/**
+		Summary of the versions which is stored in the database so that
+		some tests need not read the versions.
+		The stability bits are those of the (nonlocal) maskflags and
+		keyflags of the versions when the database is written
+		**/
+		typedef uint16_t DBFlags;
+		static CONSTEXPR const DBFlags
+			DBFLAGS_NONE                 = 0x00U,
+			DBFLAGS_NONTRIVIAL_SLOTS     = 0x01U,  ///< have_nontrivial_slots()
+			DBFLAGS_MULTI_SLOT           = 0x02U,  ///< more than one slot
+			DBFLAGS_OVERLAY              = 0x04U,  ///< some version in an overlay
+			DBFLAGS_DUP_PACKAGES         = 0x08U,  ///< !have_same_overlay_key()
+			DBFLAGS_DUP_PACKAGES_OVERLAY = 0x10U,  ///< at_least_two_overlays()
+			DBFLAGS_DUP_VERSIONS         = 0x20U,  ///< DUP_SOME
+			DBFLAGS_DUP_VERSIONS_OVERLAY = 0x40U,  ///< DUP_OVERLAYS
+			DBFLAGS_STABLE               = 0x80U,  ///< some unmasked stable version
+			DBFLAGS_TESTING              = 0x100U, ///< some unmasked stable or testing version
+			DBFLAGS_NONMASKED            = 0x200U, ///< some unmasked version
+			DBFLAGS_SYSTEM               = 0x400U, ///< some version in @system
+			DBFLAGS_PROFILE              = 0x800U, ///< some version in @profile
+			DBFLAGS_ALL                  = 0xFFFU; ///< used if unknown
+
+		DBFlags dbflags() const;
+
 		/**
 		Preset with defaults
 		**/
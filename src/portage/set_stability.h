@@ -62,6 +62,14 @@ class SetStability {
 			m_always_accept_keywords = always_accept_keywords;
 		}
 
+		bool local() const {
+			return m_local;
+		}
+
+		bool always_accept_keywords() const {
+			return m_always_accept_keywords;
+		}
+
 		ATTRIBUTE_NONNULL_ void set_stability(bool get_local, Package *package) const;
 
 		ATTRIBUTE_NONNULL_ void set_stability(Package *package) const {
@@ -15,10 +15,12 @@
 #include <cstring>
 
 #include <string>
+#include <vector>
 
 #include "eixTk/assert.h"
 #include "eixTk/likely.h"
 #include "eixTk/null.h"
+#include "eixTk/stringtypes.h"
 #include "portage/package.h"
 #include "search/levenshtein.h"
 
@@ -33,30 +35,46 @@ fnmatch(3) tells that this is a GNU extension.
 #endif
 
 using std::string;
+using std::vector;
 
 FuzzyAlgorithm::LevenshteinMap *FuzzyAlgorithm::levenshtein_map = NULLPTR;
+bool FuzzyAlgorithm::have_fuzzy = false;
 
-bool BaseAlgorithm::operator()(const char *s, Package *p, bool simplify) {
-	if(can_simplify() && unlikely(!have_simplified) && likely(simplify)) {
-		have_simplified = true;
-		// cut out the first nonempty valid search string
-		for(string::size_type i = 0; i < search_string.length(); ++i) {
-			if(likely(is_valid_pkgpath(search_string[i]))) {
-				if(unlikely(i > 0)) {
-					search_string.erase(0, i);
-				}
-				break;
+void BaseAlgorithm::simplify_string(string *s) {
+	// cut out the first nonempty valid search string
+	for(string::size_type i = 0; i < s->length(); ++i) {
+		if(likely(is_valid_pkgpath((*s)[i]))) {
+			if(unlikely(i > 0)) {
+				s->erase(0, i);
 			}
+			break;
 		}
-		for(string::size_type i = 0; i < search_string.length(); ++i) {
-			if(unlikely(!is_valid_pkgpath(search_string[i]))) {
-				if(likely(i > 0)) {
-					search_string.erase(i);
-				}
-				break;
+	}
+	for(string::size_type i = 0; i < s->length(); ++i) {
+		if(unlikely(!is_valid_pkgpath((*s)[i]))) {
+			if(likely(i > 0)) {
+				s->erase(i);
 			}
+			break;
 		}
 	}
+}
+
+void BaseAlgorithm::simplify_strings() {
+	simplify_string(&search_string);
+}
+
+void BaseAlgorithm::simplify() {
+	if(can_simplify() && unlikely(!have_simplified)) {
+		have_simplified = true;
+		simplify_strings();
+	}
+}
+
+bool BaseAlgorithm::operator()(const char *s, Package *p, bool simplify_first) {
+	if(likely(simplify_first)) {
+		simplify();
+	}
 	return (*this)(s, p);
 }
 
@@ -65,9 +83,32 @@ void FuzzyAlgorithm::init_static() {
 	levenshtein_map = new LevenshteinMap;
 }
 
-bool FuzzyAlgorithm::compare(Package *p1, Package *p2) {
-	return ((*levenshtein_map)[p1->category + "/" + p1->name]
-			< (*levenshtein_map)[p2->category + "/" + p2->name]);
+void FuzzyAlgorithm::sort_by_distance(vector<Package *> *packages) {
+	vector<Levenshtein> distances;
+	distances.reserve(packages->size());
+	Levenshtein max(0);
+	for(vector<Package *>::const_iterator it(packages->begin());
+		likely(it != packages->end()); ++it) {
+		Levenshtein d((*levenshtein_map)[(*it)->category + "/" + (*it)->name]);
+		distances.PUSH_BACK(d);
+		if(d > max) {
+			max = d;
+		}
+	}
+	// start[d] is the first position for distance d
+	vector<vector<Package *>::size_type> start(max + 2, 0);
+	for(vector<Levenshtein>::const_iterator it(distances.begin());
+		likely(it != distances.end()); ++it) {
+		++start[*it + 1];
+	}
+	for(Levenshtein d(1); likely(d <= max); ++d) {
+		start[d] += start[d - 1];
+	}
+	vector<Package *> sorted(packages->size());
+	for(vector<Package *>::size_type i(0); likely(i < packages->size()); ++i) {
+		sorted[start[distances[i]]++] = (*packages)[i];
+	}
+	packages->swap(sorted);
 }
 
 
@@ -83,8 +124,159 @@ bool FuzzyAlgorithm::operator()(const char *s, Package *p) const {
 	return ok;
 }
 
+void ExactAlgorithm::fill_alternatives() {
+	alternatives.clear();
+	alternatives.INSERT(search_string);
+	alternatives.insert(absorbed.begin(), absorbed.end());
+}
+
+void ExactAlgorithm::simplify_strings() {
+	simplify_string(&search_string);
+	for(WordVec::iterator it(absorbed.begin()); likely(it != absorbed.end()); ++it) {
+		simplify_string(&*it);
+	}
+	if(unlikely(!absorbed.empty())) {
+		fill_alternatives();
+	}
+}
+
+bool ExactAlgorithm::absorb(const BaseAlgorithm& other) {
+	const ExactAlgorithm *o(other.as_exact());
+	if((o == NULLPTR) || have_simplified || o->have_simplified) {
+		return false;
+	}
+	o->getStrings(&absorbed);
+	fill_alternatives();
+	return true;
+}
+
+void ExactAlgorithm::getStrings(WordVec *strings) const {
+	strings->PUSH_BACK(search_string);
+	strings->insert(strings->end(), absorbed.begin(), absorbed.end());
+}
+
 bool ExactAlgorithm::operator()(const char *s, Package * /* p */) const {
-	return (std::strcmp(search_string.c_str(), s) == 0);
+	if(likely(absorbed.empty())) {
+		return (std::strcmp(search_string.c_str(), s) == 0);
+	}
+	return (alternatives.count(s) != 0);
+}
+
+void SubstringAlgorithm::simplify_strings() {
+	simplify_string(&search_string);
+	for(WordVec::iterator it(absorbed.begin()); likely(it != absorbed.end()); ++it) {
+		simplify_string(&*it);
+	}
+	have_automaton = false;
+}
+
+bool SubstringAlgorithm::absorb(const BaseAlgorithm& other) {
+	const SubstringAlgorithm *o(other.as_substring());
+	if((o == NULLPTR) || have_simplified || o->have_simplified) {
+		return false;
+	}
+	o->getStrings(&absorbed);
+	have_automaton = false;
+	return true;
+}
+
+void SubstringAlgorithm::getStrings(WordVec *strings) const {
+	strings->PUSH_BACK(search_string);
+	strings->insert(strings->end(), absorbed.begin(), absorbed.end());
+}
+
+/**
+Build a deterministic Aho-Corasick automaton for all strings:
+First the trie of the strings is built; then in breadth first order the
+failure links are calculated and the missing transitions of each state are
+copied from the state of its failure link.
+If the automaton would become too large, transition is left empty.
+**/
+void SubstringAlgorithm::build_automaton() const {
+	have_automaton = true;
+	match_all = false;
+	transition.clear();
+	final.clear();
+	WordVec strings;
+	getStrings(&strings);
+	string::size_type total(0);
+	for(WordVec::const_iterator it(strings.begin()); likely(it != strings.end()); ++it) {
+		if(unlikely(it->empty())) {
+			match_all = true;
+			return;
+		}
+		total += it->size();
+	}
+	if(unlikely(total >= 0x4000)) {
+		return;
+	}
+	transition.assign(256, 0);
+	final.assign(1, false);
+	for(WordVec::const_iterator it(strings.begin()); likely(it != strings.end()); ++it) {
+		State state(0);
+		for(string::const_iterator c(it->begin()); likely(c != it->end()); ++c) {
+			std::vector<State>::size_type i((state << 8) | static_cast<unsigned char>(*c));
+			if(transition[i] == 0) {
+				transition[i] = final.size();
+				final.PUSH_BACK(false);
+				transition.resize(transition.size() + 256, 0);
+			}
+			state = transition[i];
+		}
+		final[state] = true;
+	}
+	std::vector<State> fail(final.size(), 0);
+	// The states in breadth first order; todo grows while being traversed
+	std::vector<State> todo;
+	for(State c(0); c < 256; ++c) {
+		if(transition[c] != 0) {
+			todo.PUSH_BACK(transition[c]);
+		}
+	}
+	for(std::vector<State>::size_type i(0); i < todo.size(); ++i) {
+		State state(todo[i]);
+		State state_offset(state << 8), fail_offset(fail[state] << 8);
+		for(State c(0); c < 256; ++c) {
+			State next(transition[state_offset | c]);
+			if(next == 0) {
+				transition[state_offset | c] = transition[fail_offset | c];
+				continue;
+			}
+			fail[next] = transition[fail_offset | c];
+			if(final[fail[next]]) {
+				final[next] = true;
+			}
+			todo.PUSH_BACK(next);
+		}
+	}
+}
+
+bool SubstringAlgorithm::automaton_match(const char *s) const {
+	if(unlikely(!have_automaton)) {
+		build_automaton();
+	}
+	if(unlikely(match_all)) {
+		return true;
+	}
+	if(unlikely(transition.empty())) {
+		if(std::strstr(s, search_string.c_str()) != NULLPTR) {
+			return true;
+		}
+		for(WordVec::const_iterator it(absorbed.begin()); likely(it != absorbed.end()); ++it) {
+			if(std::strstr(s, it->c_str()) != NULLPTR) {
+				return true;
+			}
+		}
+		return false;
+	}
+	State state(0);
+	for(; *s != '\0'; ++s) {
+		state = transition[(state << 8) | static_cast<unsigned char>(*s)];
+		if(final[state]) {
+			return true;
+		}
+	}
+	return false;
 }
 
 bool BeginAlgorithm::operator()(const char *s, Package * /* p */) const {
@@ -12,15 +12,27 @@
 
 #include <config.h>  // IWYU pragma: keep
 
+#include <cstring>
+
 #include <string>
+#include <vector>
 
 #include "eixTk/attribute.h"
 #include "eixTk/dialect.h"
+#include "eixTk/inttypes.h"
+#include "eixTk/likely.h"
+#include "eixTk/null.h"
 #include "eixTk/regexp.h"
+#include "eixTk/stringtypes.h"
 #include "eixTk/unordered_map.h"
 #include "search/levenshtein.h"
 
+class BeginAlgorithm;
+class EndAlgorithm;
+class ExactAlgorithm;
+class FuzzyAlgorithm;
 class Package;
+class SubstringAlgorithm;
 class matchtree;
 
 /**
@@ -37,6 +49,14 @@ class BaseAlgorithm {
 			return true;
 		}
 
+		/**
+		Cut search_string (and all absorbed strings) to the first
+		valid part of a package name
+		**/
+		virtual void simplify_strings();
+
+		ATTRIBUTE_NONNULL_ static void simplify_string(std::string *s);
+
 	public:
 		virtual void setString(const std::string& s) {
 			search_string = s;
@@ -46,9 +66,74 @@ class BaseAlgorithm {
 		virtual ~BaseAlgorithm() {
 		}
 
+		const std::string& getString() const {
+			return search_string;
+		}
+
+		/**
+		Rough relative cost of one call; used for ordering tests
+		**/
+		virtual unsigned int cost() const {
+			return 1;
+		}
+
+		/**
+		@return true if calls must neither be skipped nor reordered
+		**/
+		virtual bool has_side_effects() const {
+			return false;
+		}
+
+		/**
+		Take over the search strings of other, i.e. afterwards match
+		whenever this or other would have matched before.
+		@return false if this is not possible for the type of other
+		**/
+		virtual bool absorb(const BaseAlgorithm& /* other */) {
+			return false;
+		}
+
+		/**
+		Append search_string and all absorbed strings
+		**/
+		ATTRIBUTE_NONNULL_ virtual void getStrings(WordVec *strings) const {
+			strings->PUSH_BACK(search_string);
+		}
+
+		virtual const ExactAlgorithm *as_exact() const {
+			return NULLPTR;
+		}
+
+		virtual const SubstringAlgorithm *as_substring() const {
+			return NULLPTR;
+		}
+
+		virtual const BeginAlgorithm *as_begin() const {
+			return NULLPTR;
+		}
+
+		virtual const EndAlgorithm *as_end() const {
+			return NULLPTR;
+		}
+
+		virtual const FuzzyAlgorithm *as_fuzzy() const {
+			return NULLPTR;
+		}
+
+		/**
+		Simplify the search strings now (if this is admissible) as it
+		would happen when matching with simplify = true
+		**/
+		void simplify();
+
+		/**
+		@return the command line option selecting this algorithm
+		**/
+		virtual const char *option() const = 0;
+
 		ATTRIBUTE_NONNULL((2)) virtual bool operator()(const char *s, Package *p) const = 0;
 
-		ATTRIBUTE_NONNULL((2)) bool operator()(const char *s, Package *p, bool simplify);
+		ATTRIBUTE_NONNULL((2)) bool operator()(const char *s, Package *p, bool simplify_first);
 };
 
 /**
@@ -63,31 +148,110 @@ class RegexAlgorithm FINAL : public BaseAlgorithm {
 		}
 
 	public:
+		unsigned int cost() const OVERRIDE {
+			return 4;
+		}
+
 		void setString(const std::string& s) OVERRIDE {
 			search_string = s;
 			re.compile(search_string.c_str(), REG_ICASE);
 		}
 
+		const char *option() const OVERRIDE {
+			return "--regex";
+		}
+
 		ATTRIBUTE_NONNULL((2)) bool operator()(const char *s, Package * /* p */) const OVERRIDE {
 			return re.match(s);
 		}
 };
 
 /**
-exact string matching
+exact string matching; several absorbed strings are looked up in a hash
 **/
 class ExactAlgorithm FINAL : public BaseAlgorithm {
+	protected:
+		WordVec absorbed;
+
+		/**
+		search_string and absorbed; only used if absorbed is nonempty
+		**/
+		WordUnorderedSet alternatives;
+
+		void simplify_strings() OVERRIDE;
+
+		void fill_alternatives();
+
 	public:
+		bool absorb(const BaseAlgorithm& other) OVERRIDE;
+
+		ATTRIBUTE_NONNULL_ void getStrings(WordVec *strings) const OVERRIDE;
+
+		const ExactAlgorithm *as_exact() const OVERRIDE {
+			return this;
+		}
+
+		const char *option() const OVERRIDE {
+			return "--exact";
+		}
+
 		ATTRIBUTE_NONNULL((2)) ATTRIBUTE_PURE bool operator()(const char *s, Package * /* p */) const OVERRIDE;
 };
 
 /**
-substring matching
+substring matching; several absorbed strings are searched simultaneously
+with an Aho-Corasick automaton
 **/
 class SubstringAlgorithm FINAL : public BaseAlgorithm {
+	protected:
+		typedef uint32_t State;
+
+		WordVec absorbed;
+
+		/**
+		The automaton is built lazily on first use after absorb()
+		**/
+		mutable bool have_automaton;
+
+		/**
+		Some of the strings is empty (and thus always matches)
+		**/
+		mutable bool match_all;
+
+		/**
+		transition[256 * state + c] is the state after reading c;
+		final[state] means that some string ends at state
+		**/
+		mutable std::vector<State> transition;
+		mutable std::vector<bool> final;
+
+		void simplify_strings() OVERRIDE;
+
+		void build_automaton() const;
+
+		ATTRIBUTE_NONNULL_ bool automaton_match(const char *s) const;
+
 	public:
+		SubstringAlgorithm() : have_automaton(false), match_all(false) {
+		}
+
+		bool absorb(const BaseAlgorithm& other) OVERRIDE;
+
+		ATTRIBUTE_NONNULL_ void getStrings(WordVec *strings) const OVERRIDE;
+
+		const SubstringAlgorithm *as_substring() const OVERRIDE {
+			return this;
+		}
+
+		const char *option() const OVERRIDE {
+			return "--substring";
+		}
+
 		ATTRIBUTE_NONNULL((2)) bool operator()(const char *s, Package * /* p */) const OVERRIDE {
-			return (std::string(s).find(search_string) != std::string::npos);
+			if(likely(absorbed.empty())) {
+				return (std::strstr(s, search_string.c_str()) != NULLPTR);
+			}
+			return automaton_match(s);
 		}
 };
 
@@ -96,6 +260,14 @@ begin-of-string matching
 **/
 class BeginAlgorithm FINAL : public BaseAlgorithm {
 	public:
+		const BeginAlgorithm *as_begin() const OVERRIDE {
+			return this;
+		}
+
+		const char *option() const OVERRIDE {
+			return "--begin";
+		}
+
 		ATTRIBUTE_NONNULL((2)) ATTRIBUTE_PURE bool operator()(const char *s, Package * /* p */) const OVERRIDE;
 };
 
@@ -104,6 +276,14 @@ end-of-string matching
 **/
 class EndAlgorithm FINAL : public BaseAlgorithm {
 	public:
+		const EndAlgorithm *as_end() const OVERRIDE {
+			return this;
+		}
+
+		const char *option() const OVERRIDE {
+			return "--end";
+		}
+
 		ATTRIBUTE_NONNULL((2)) ATTRIBUTE_PURE bool operator()(const char *s, Package * /* p */) const OVERRIDE;
 };
 
@@ -116,27 +296,62 @@ class FuzzyAlgorithm FINAL : public BaseAlgorithm {
 		Levenshtein max_levenshteindistance;
 
 		/**
-		FIXME: We need to have a package->levenshtein mapping that we can
-		access from the static FuzzyAlgorithm::compare.
-		I really don't know how to do this ..
+		The distances of the matching packages for sort_by_distance()
 		**/
 		typedef UNORDERED_MAP<std::string, Levenshtein> LevenshteinMap;
 		static LevenshteinMap *levenshtein_map;
 
+		/**
+		Some FuzzyAlgorithm was created, i.e. the matches are sorted
+		**/
+		static bool have_fuzzy;
+
 		bool can_simplify() const OVERRIDE {
 			return false;
 		}
 
 	public:
 		explicit FuzzyAlgorithm(Levenshtein max) : max_levenshteindistance(max) {
+			have_fuzzy = true;
+		}
+
+		unsigned int cost() const OVERRIDE {
+			return 8;
+		}
+
+		/**
+		The distance is stored for sorting the output
+		**/
+		bool has_side_effects() const OVERRIDE {
+			return true;
+		}
+
+		const FuzzyAlgorithm *as_fuzzy() const OVERRIDE {
+			return this;
+		}
+
+		Levenshtein max_distance() const {
+			return max_levenshteindistance;
+		}
+
+		const char *option() const OVERRIDE {
+			return "--fuzzy";
 		}
 
 		ATTRIBUTE_NONNULL((2)) bool operator()(const char *s, Package *p) const OVERRIDE;
 
-		ATTRIBUTE_NONNULL_ static bool compare(Package *p1, Package *p2);
+		/**
+		Sort the matches by their distance, keeping the order for equal
+		distances. The distances are small, so we use a bucket sort
+		**/
+		ATTRIBUTE_NONNULL_ static void sort_by_distance(std::vector<Package *> *packages);
 
+		/**
+		@return true if the matches must be sorted; this is known already
+		before the first package is matched
+		**/
 		static bool sort_by_levenshtein() {
-			return (!levenshtein_map->empty());
+			return have_fuzzy;
 		}
 
 		static void init_static();
@@ -152,6 +367,14 @@ class PatternAlgorithm FINAL : public BaseAlgorithm {
 		}
 
 	public:
+		unsigned int cost() const OVERRIDE {
+			return 2;
+		}
+
+		const char *option() const OVERRIDE {
+			return "--pattern";
+		}
+
 		ATTRIBUTE_NONNULL((2)) bool operator()(const char *s, Package * /* p */) const OVERRIDE;
 };
 
@@ -14,14 +14,38 @@
 #include <cstdlib>
 #endif
 
+#include <algorithm>
 #include <stack>
+#include <string>
+#include <vector>
 
+#include "eixTk/dialect.h"
 #include "eixTk/formated.h"
 #include "eixTk/i18n.h"
 #include "eixTk/likely.h"
 #include "eixTk/null.h"
 #include "search/packagetest.h"
 
+using std::string;
+using std::vector;
+
+ATTRIBUTE_PURE static bool cheaper(const MatchAtom *a, const MatchAtom *b);
+static void explain_line(unsigned int depth, const string& text, unsigned int cost);
+
+/**
+A missing operand means "true" and costs nothing
+**/
+static bool cheaper(const MatchAtom *a, const MatchAtom *b) {
+	if(b == NULLPTR) {
+		return false;
+	}
+	return ((a == NULLPTR) || (a->cost() < b->cost()));
+}
+
+static void explain_line(unsigned int depth, const string& text, unsigned int cost) {
+	eix::say("%s%s (cost %s)") % string(2 * depth, ' ') % text % cost;
+}
+
 bool MatchAtom::match(PackageReader * /* p */) {
 #ifdef DEBUG_MATCHTREE
 	eix::print(m_negate ? " '!' " : " '' ");
@@ -30,6 +54,15 @@ bool MatchAtom::match(PackageReader * /* p */) {
 	return !m_negate;
 }
 
+unsigned int MatchAtom::plan(bool * /* reorderable */) {
+	m_cost = 0;
+	return 0;
+}
+
+void MatchAtom::explain(unsigned int depth) const {
+	explain_line(depth, (m_negate ? "false" : "true"), m_cost);
+}
+
 MatchAtomOperator::~MatchAtomOperator() {
 	delete m_left;
 	delete m_right;
@@ -68,6 +101,113 @@ bool MatchAtomOperator::match(PackageReader *p) {
 	return is_match;
 }
 
+void MatchAtomOperator::collect(vector<MatchAtom *> *operands, vector<MatchAtomOperator *> *inner) const {
+	MatchAtom *children[2] = { m_left, m_right };
+	for(unsigned int i(0); i < 2; ++i) {
+		MatchAtom *child(children[i]);
+		MatchAtomOperator *op((child == NULLPTR) ? NULLPTR : child->as_operator());
+		if((op != NULLPTR) && (op->m_operator == m_operator) && !(op->m_negate)) {
+			inner->PUSH_BACK(op);
+			op->collect(operands, inner);
+		} else {
+			operands->PUSH_BACK(child);
+		}
+	}
+}
+
+void MatchAtomOperator::merge_tests(vector<MatchAtom *> *operands, vector<MatchAtomOperator *> *inner) {
+	for(vector<MatchAtom *>::size_type i(0); i < operands->size(); ++i) {
+		MatchAtomTest *test(((*operands)[i] == NULLPTR) ? NULLPTR : (*operands)[i]->as_test());
+		if(test == NULLPTR) {
+			continue;
+		}
+		for(vector<MatchAtom *>::size_type j(i + 1); j < operands->size(); ) {
+			MatchAtomTest *other(((*operands)[j] == NULLPTR) ? NULLPTR : (*operands)[j]->as_test());
+			if((other == NULLPTR) || !test->absorb(other)) {
+				++j;
+				continue;
+			}
+			delete other;
+			operands->erase(operands->begin() + j);
+			if(likely(!inner->empty())) {
+				MatchAtomOperator *op(inner->back());
+				inner->pop_back();
+				op->m_left = op->m_right = NULLPTR;
+				delete op;
+			}
+		}
+	}
+}
+
+unsigned int MatchAtomOperator::plan(bool *reorderable) {
+	vector<MatchAtom *> operands;
+	vector<MatchAtomOperator *> inner;
+	collect(&operands, &inner);
+	bool chain_reorderable(true);
+	m_cost = 0;
+	for(vector<MatchAtom *>::const_iterator it(operands.begin());
+		likely(it != operands.end()); ++it) {
+		if(*it != NULLPTR) {
+			m_cost += (*it)->plan(&chain_reorderable);
+		}
+	}
+	if(!chain_reorderable) {
+		*reorderable = false;
+		return m_cost;
+	}
+	if(m_operator == AtomOr) {
+		vector<MatchAtom *>::size_type count(operands.size());
+		merge_tests(&operands, &inner);
+		if(operands.size() != count) {
+			m_cost = 0;
+			for(vector<MatchAtom *>::const_iterator it(operands.begin());
+				likely(it != operands.end()); ++it) {
+				if(*it != NULLPTR) {
+					m_cost += (*it)->cost();
+				}
+			}
+			if(operands.size() == 1) {
+				// Everything was merged; a missing operand of -a means "true"
+				m_operator = AtomAnd;
+				operands.PUSH_BACK(NULLPTR);
+			}
+		}
+	}
+	std::stable_sort(operands.begin(), operands.end(), cheaper);
+	// Rebuild the chain as ((o_0 op o_1) op o_2) op ... with this on top
+	MatchAtom *curr(operands[0]);
+	for(vector<MatchAtomOperator *>::size_type i(0); i <= inner.size(); ++i) {
+		MatchAtomOperator *op((i == inner.size()) ? this : inner[i]);
+		op->m_left = curr;
+		op->m_right = operands[i + 1];
+		curr = op;
+	}
+	return m_cost;
+}
+
+void MatchAtomOperator::explain(unsigned int depth) const {
+	vector<MatchAtom *> operands;
+	vector<MatchAtomOperator *> inner;
+	collect(&operands, &inner);
+	if((m_operator == AtomAnd) && !m_negate && (operands.size() == 2) &&
+		((operands[0] == NULLPTR) != (operands[1] == NULLPTR))) {
+		// "x -a true" is just x
+		((operands[0] == NULLPTR) ? operands[1] : operands[0])->explain(depth);
+		return;
+	}
+	string text(m_negate ? "--not " : "");
+	text.append((m_operator == AtomAnd) ? "--and" : "--or");
+	explain_line(depth, text, m_cost);
+	for(vector<MatchAtom *>::const_iterator it(operands.begin());
+		likely(it != operands.end()); ++it) {
+		if(*it == NULLPTR) {
+			explain_line(depth + 1, "true", 0);
+		} else {
+			(*it)->explain(depth + 1);
+		}
+	}
+}
+
 MatchAtomTest::~MatchAtomTest() {
 #ifndef DEBUG_MATCHTREE
 	delete m_test;
@@ -88,10 +228,16 @@ bool MatchAtomTest::match(PackageReader *p) {
 	eix::print("] ");
 	return false;
 #else
-	bool is_match((likely(m_pipe == NULLPTR)) ||
-		(((*m_pipe) != NULLPTR) && (*m_pipe)->match(p)));
-	if(is_match && ((likely(m_test != NULLPTR)) && !(m_test->match(p)))) {
-		is_match = false;
+	bool is_match;
+	if(unlikely(m_test_first)) {
+		is_match = (m_test->match(p) &&
+			((*m_pipe) != NULLPTR) && (*m_pipe)->match(p));
+	} else {
+		is_match = ((likely(m_pipe == NULLPTR)) ||
+			(((*m_pipe) != NULLPTR) && (*m_pipe)->match(p)));
+		if(is_match && ((likely(m_test != NULLPTR)) && !(m_test->match(p)))) {
+			is_match = false;
+		}
 	}
 	if(m_negate) {
 		return !is_match;
@@ -100,6 +246,60 @@ bool MatchAtomTest::match(PackageReader *p) {
 #endif
 }
 
+unsigned int MatchAtomTest::plan(bool *reorderable) {
+	bool test_reorderable(true);
+	m_cost = 0;
+	if(likely(m_test != NULLPTR)) {
+		m_cost = m_test->cost();
+		test_reorderable = m_test->reorderable();
+	}
+	m_test_first = false;
+	if(unlikely((m_pipe != NULLPTR) && ((*m_pipe) != NULLPTR))) {
+		bool pipe_reorderable(true);
+		unsigned int pipe_cost((*m_pipe)->plan(&pipe_reorderable));
+		m_test_first = ((m_test != NULLPTR) &&
+			test_reorderable && pipe_reorderable && (m_cost < pipe_cost));
+		m_cost += pipe_cost;
+		if(!pipe_reorderable) {
+			*reorderable = false;
+		}
+	}
+	if(!test_reorderable) {
+		*reorderable = false;
+	}
+	return m_cost;
+}
+
+void MatchAtomTest::explain(unsigned int depth) const {
+	string text(m_negate ? "--not" : "");
+	if(likely(m_test != NULLPTR)) {
+		const string test(m_test->explain());
+		if(!test.empty()) {
+			if(!text.empty()) {
+				text.append(1, ' ');
+			}
+			text.append(test);
+		}
+	}
+	if(m_pipe != NULLPTR) {
+		if(!text.empty()) {
+			text.append(1, ' ');
+		}
+		text.append(m_test_first ? "--pipe (test before pipe)" : "--pipe");
+	}
+	if(text.empty()) {
+		text.assign("true");
+	}
+	explain_line(depth, text, m_cost);
+}
+
+bool MatchAtomTest::absorb(const MatchAtomTest *other) {
+	return (!m_negate && !(other->m_negate) &&
+		(m_pipe == NULLPTR) && (other->m_pipe == NULLPTR) &&
+		(m_test != NULLPTR) && (other->m_test != NULLPTR) &&
+		m_test->absorb(other->m_test));
+}
+
 void MatchAtomTest::set_test(PackageTest *gtest) {
 #ifdef DEBUG_MATCHTREE
 	static int t_count(0);
@@ -270,6 +470,21 @@ void MatchTree::parse_close() {
 	parse_closeforce();
 }
 
+void MatchTree::plan() {
+	if(root != NULLPTR) {
+		bool reorderable(true);
+		root->plan(&reorderable);
+	}
+}
+
+void MatchTree::explain() const {
+	if(root == NULLPTR) {
+		explain_line(0, "true", 0);
+		return;
+	}
+	root->explain(0);
+}
+
 void MatchTree::end_parse() {
 	parse_local_negate();
 	while(!parser_stack.empty()) {
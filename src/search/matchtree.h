@@ -11,6 +11,7 @@
 #include <config.h>  // IWYU pragma: keep
 
 #include <stack>
+#include <vector>
 
 #include "eixTk/attribute.h"
 #include "eixTk/dialect.h"
@@ -27,11 +28,16 @@ class MatchAtom {
 	protected:
 		bool m_negate;
 
+		/**
+		Estimated cost of match() as calculated by plan()
+		**/
+		unsigned int m_cost;
+
 	public:
-		MatchAtom() : m_negate(false) {
+		MatchAtom() : m_negate(false), m_cost(0) {
 		}
 
-		explicit MatchAtom(bool negate) : m_negate(negate) {
+		explicit MatchAtom(bool negate) : m_negate(negate), m_cost(0) {
 		}
 
 		/**
@@ -47,6 +53,23 @@ class MatchAtom {
 		**/
 		ATTRIBUTE_PURE virtual bool match(PackageReader *p);
 
+		/**
+		Reorder (recursively) the operands by estimated cost.
+		@param reorderable is set to false if the atom must not be
+		moved, i.e. if it contains a test with side effects
+		@return estimated cost of match()
+		**/
+		ATTRIBUTE_NONNULL_ virtual unsigned int plan(bool *reorderable);
+
+		/**
+		Print the atom in the order of evaluation for --explain
+		**/
+		virtual void explain(unsigned int depth) const;
+
+		unsigned int cost() const {
+			return m_cost;
+		}
+
 		virtual MatchAtomOperator *as_operator() {
 			return NULLPTR;
 		}
@@ -56,13 +79,25 @@ class MatchAtom {
 		}
 };
 
-class MatchAtomOperator : public MatchAtom {
+class MatchAtomOperator FINAL : public MatchAtom {
 		friend class MatchTree;
 	private:
 		enum AtomOperator { AtomAnd, AtomOr };
 		AtomOperator m_operator;
 		MatchAtom *m_left, *m_right;
 
+		/**
+		Collect the operands of the chain of equal operators starting at
+		this and all but the topmost of these operators
+		**/
+		ATTRIBUTE_NONNULL_ void collect(std::vector<MatchAtom *> *operands, std::vector<MatchAtomOperator *> *inner) const;
+
+		/**
+		Merge simple string tests of an || chain into their first
+		absorbing sibling and drop the corresponding operators
+		**/
+		ATTRIBUTE_NONNULL_ static void merge_tests(std::vector<MatchAtom *> *operands, std::vector<MatchAtomOperator *> *inner);
+
 	public:
 		explicit MatchAtomOperator(AtomOperator op)
 			: m_operator(op), m_left(NULLPTR), m_right(NULLPTR) {
@@ -72,27 +107,52 @@ class MatchAtomOperator : public MatchAtom {
 
 		bool match(PackageReader *p) OVERRIDE;
 
+		/**
+		Sort the operands of a chain of equal operators by cost.
+		This is valid since a missing operand means "true", and since
+		&& and || are commutative if the tests have no side effects.
+		**/
+		ATTRIBUTE_NONNULL_ unsigned int plan(bool *reorderable) OVERRIDE;
+
+		void explain(unsigned int depth) const OVERRIDE;
+
 		MatchAtomOperator *as_operator() OVERRIDE {
 			return this;
 		}
 };
 
-class MatchAtomTest : public MatchAtom {
+class MatchAtomTest FINAL : public MatchAtom {
 		friend class MatchTree;
 	private:
 		PackageTest *m_test;
 		MatchAtom **m_pipe;
 
+		/**
+		Is m_test cheaper than the pipe test?
+		**/
+		bool m_test_first;
+
 	public:
-		MatchAtomTest() : m_test(NULLPTR), m_pipe(NULLPTR) {
+		MatchAtomTest() : m_test(NULLPTR), m_pipe(NULLPTR), m_test_first(false) {
 		}
 
 		~MatchAtomTest();
 
 		bool match(PackageReader *p) OVERRIDE;
 
+		ATTRIBUTE_NONNULL_ unsigned int plan(bool *reorderable) OVERRIDE;
+
+		void explain(unsigned int depth) const OVERRIDE;
+
 		void set_test(PackageTest *gtest);
 
+		/**
+		Take over the test of other so that this matches if this or
+		other matched before; this is only possible for string tests.
+		@return true if this succeeded; other must be deleted then
+		**/
+		ATTRIBUTE_NONNULL_ bool absorb(const MatchAtomTest *other);
+
 		MatchAtomTest *as_test() OVERRIDE {
 			return this;
 		}
@@ -191,6 +251,17 @@ class MatchTree {
 		void parse_close();
 
 		void end_parse();
+
+		/**
+		Reorder the tests by estimated cost.
+		Must be called after end_parse() and set_pipetest().
+		**/
+		void plan();
+
+		/**
+		Print the tests in the order of evaluation
+		**/
+		void explain() const;
 };
 
 #endif  // SRC_SEARCH_MATCHTREE_H_
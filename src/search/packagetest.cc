@@ -10,12 +10,19 @@
 #include "search/packagetest.h"
 #include <config.h>  // IWYU pragma: keep
 
+#include <set>
 #include <string>
+#include <vector>
 
+#include "database/header.h"
+#include "database/name_index.h"
 #include "database/package_reader.h"
 #include "eixTk/attribute.h"
+#include "eixTk/dialect.h"
 #include "eixTk/eixint.h"
 #include "eixTk/filenames.h"
+#include "eixTk/formated.h"
+#include "eixTk/i18n.h"
 #include "eixTk/likely.h"
 #include "eixTk/null.h"
 #include "eixTk/stringtypes.h"
@@ -32,10 +39,12 @@
 #include "portage/mask_list.h"
 #include "portage/package.h"
 #include "portage/vardbpkg.h"
+#include "portage/version.h"
 #include "search/algorithms.h"
 #include "search/nowarn.h"
 
 using std::string;
+using std::vector;
 
 class DBHeader;
 class SetStability;
@@ -108,9 +117,17 @@ PackageTest::PackageTest(VarDbPkg *vdb, PortageSettings *p, const PrintFormat *f
 	from_overlay_inst_list = NULLPTR;
 	from_foreign_overlay_inst_list = NULLPTR;
 	marked_list = NULLPTR;
+	iuse_candidates = NULLPTR;
+	know_iuse_candidates = false;
+	name_candidates = NULLPTR;
+	know_name_candidates = false;
+	revdep_candidates = NULLPTR;
+	know_revdep_candidates = false;
 
 	field = NONE;
 	need = PackageReader::NONE;
+	require_dbflags = Package::DBFLAGS_NONE;
+	cost_estimate = 0;
 	overlay = obsolete = upgrade = installed = multi_installed =
 		slotted = multi_slot =
 		world = world_only_selected = world_only_file =
@@ -133,6 +150,9 @@ PackageTest::~PackageTest() {
 	delete in_overlay_inst_list;
 	delete from_overlay_inst_list;
 	delete from_foreign_overlay_inst_list;
+	delete iuse_candidates;
+	delete name_candidates;
+	delete revdep_candidates;
 }
 
 void PackageTest::calculateNeeds() {
@@ -182,6 +202,90 @@ void PackageTest::calculateNeeds() {
 		(test_stability_local != STABLE_NONE) ||
 		(test_stability_nonlocal != STABLE_NONE))
 		setNeeds(PackageReader::VERSIONS);
+	// Without the index of the database --rdeps reads the dependencies
+	if(!revdep_name.empty() && (header->revdep_index_offset == 0)) {
+		setNeeds(PackageReader::VERSIONS);
+	}
+}
+
+void PackageTest::calculateDBFlags() {
+	Package::DBFlags flags(Package::DBFLAGS_NONE);
+	if(slotted) {
+		flags |= Package::DBFLAGS_NONTRIVIAL_SLOTS;
+		if(multi_slot) {
+			flags |= Package::DBFLAGS_MULTI_SLOT;
+		}
+	}
+	if(overlay) {
+		flags |= Package::DBFLAGS_OVERLAY;
+	}
+	if(dup_packages) {
+		flags |= (dup_packages_overlay ?
+			Package::DBFLAGS_DUP_PACKAGES_OVERLAY :
+			Package::DBFLAGS_DUP_PACKAGES);
+	}
+	if(dup_versions) {
+		flags |= (dup_versions_overlay ?
+			Package::DBFLAGS_DUP_VERSIONS_OVERLAY :
+			Package::DBFLAGS_DUP_VERSIONS);
+	}
+	// The stored stability is nonlocal and valid only for the same keywords
+	TestStability what(test_stability_nonlocal);
+	if(!stability->local()) {
+		what |= test_stability_default;
+	}
+	if((what & STABLE_SYSTEM) != STABLE_NONE) {
+		flags |= Package::DBFLAGS_SYSTEM;
+	}
+	if((what & STABLE_PROFILE) != STABLE_NONE) {
+		flags |= Package::DBFLAGS_PROFILE;
+	}
+	if((what & ~STABLE_SYSTEMPROFILE) != STABLE_NONE) {
+		flags |= Package::DBFLAGS_NONMASKED;
+	}
+	if(header->always_accept_keywords == stability->always_accept_keywords()) {
+		if((what & STABLE_FULL) != STABLE_NONE) {
+			flags |= Package::DBFLAGS_STABLE;
+		} else if((what & STABLE_TESTING) != STABLE_NONE) {
+			flags |= Package::DBFLAGS_TESTING;
+		}
+	}
+	require_dbflags = flags;
+}
+
+/**
+The weights only need to give the order:
+name < installed < description < versions < deps < stability < vdb files
+**/
+void PackageTest::calculateCost() {
+	Cost cost(8 * static_cast<Cost>(need));
+	if(algorithm != NULLPTR) {
+		cost += algorithm->cost();
+	}
+	if(installed) {
+		cost += 4;
+	}
+	if(((field & DEPSA) != NONE) || !revdep_name.empty()) {
+		cost += 16;
+	}
+	if(obsolete || upgrade || world || worldset ||
+		(test_instability != STABLE_NONE) ||
+		(test_stability_default != STABLE_NONE) ||
+		(test_stability_local != STABLE_NONE) ||
+		(test_stability_nonlocal != STABLE_NONE)) {
+		cost += 24;
+	}
+	// Tests which might need to read files of installed packages
+	if(((field & (USE_ENABLED | USE_DISABLED | INST_EAPI | INST_SLOT | INST_FULLSLOT | DEPSI)) != NONE) ||
+		(in_overlay_inst_list != NULLPTR) ||
+		(from_overlay_inst_list != NULLPTR) ||
+		(from_foreign_overlay_inst_list != NULLPTR) ||
+		(restrictions != ExtendedVersion::RESTRICT_NONE) ||
+		(properties != ExtendedVersion::PROPERTIES_NONE) ||
+		(binarynum != 0)) {
+		cost += 48;
+	}
+	cost_estimate = cost;
 }
 
 void PackageTest::finalize() {
@@ -189,6 +293,267 @@ void PackageTest::finalize() {
 		setPattern("");
 	}
 	calculateNeeds();
+	calculateDBFlags();
+	calculateCost();
+}
+
+bool PackageTest::reorderable() const {
+	return ((algorithm == NULLPTR) || !algorithm->has_side_effects());
+}
+
+bool PackageTest::only_string_test() const {
+	return ((algorithm != NULLPTR) &&
+		!(overlay || obsolete || upgrade || installed || slotted ||
+		world || worldset || have_virtual || have_nonvirtual ||
+		dup_versions || dup_packages) &&
+		(binarynum == 0) &&
+		(restrictions == ExtendedVersion::RESTRICT_NONE) &&
+		(properties == ExtendedVersion::PROPERTIES_NONE) &&
+		(overlay_list == NULLPTR) && (overlay_only_list == NULLPTR) &&
+		(in_overlay_inst_list == NULLPTR) &&
+		(from_overlay_inst_list == NULLPTR) &&
+		(from_foreign_overlay_inst_list == NULLPTR) &&
+		(marked_list == NULLPTR) && revdep_name.empty() &&
+		((test_stability_default | test_stability_local |
+		test_stability_nonlocal | test_instability) == STABLE_NONE));
+}
+
+bool PackageTest::absorb(const PackageTest *other) {
+	return ((field == other->field) &&
+		only_string_test() && other->only_string_test() &&
+		algorithm->absorb(*(other->algorithm)));
+}
+
+ATTRIBUTE_NONNULL_ static void append_word(string *s, const char *word);
+static void append_word(string *s, const char *word) {
+	if(!s->empty()) {
+		s->append(1, ' ');
+	}
+	s->append(word);
+}
+
+ATTRIBUTE_NONNULL_ static void append_quoted(string *s, const string& word);
+static void append_quoted(string *s, const string& word) {
+	string escaped(word);
+	escape_string(&escaped, doublequotes);
+	s->append(" \"");
+	s->append(escaped);
+	s->append(1, '"');
+}
+
+ATTRIBUTE_NONNULL_ static void append_stability(string *s, PackageTest::TestStability what, const char *suffix);
+static void append_stability(string *s, PackageTest::TestStability what, const char *suffix) {
+	static CONSTEXPR const struct {
+		PackageTest::TestStability stability;
+		const char *name;
+	} stability_names[] = {
+		{ PackageTest::STABLE_FULL,      "--stable" },
+		{ PackageTest::STABLE_TESTING,   "--testing" },
+		{ PackageTest::STABLE_NONMASKED, "--non-masked" },
+		{ PackageTest::STABLE_SYSTEM,    "--system" },
+		{ PackageTest::STABLE_PROFILE,   "--profile" }
+	};
+	for(unsigned int i(0); i < sizeof(stability_names) / sizeof(stability_names[0]); ++i) {
+		if((what & stability_names[i].stability) != PackageTest::STABLE_NONE) {
+			append_word(s, stability_names[i].name);
+			s->append(suffix);
+		}
+	}
+}
+
+ATTRIBUTE_NONNULL((1, 2)) static void append_overlays(string *s, const char *option, const std::set<ExtendedVersion::Overlay> *overlays);
+static void append_overlays(string *s, const char *option, const std::set<ExtendedVersion::Overlay> *overlays) {
+	if(overlays == NULLPTR) {
+		return;
+	}
+	if(overlays->empty()) {
+		append_word(s, option);
+		return;
+	}
+	for(std::set<ExtendedVersion::Overlay>::const_iterator it(overlays->begin());
+		likely(it != overlays->end()); ++it) {
+		append_word(s, option);
+		s->append(eix::format(" %s") % *it);
+	}
+}
+
+string PackageTest::explain() const {
+	static CONSTEXPR const struct {
+		MatchField field;
+		const char *name;
+	} field_names[] = {
+		{ NAME,          "--name" },
+		{ DESCRIPTION,   "--description" },
+		{ LICENSE,       "--license" },
+		{ CATEGORY,      "--category" },
+		{ CATEGORY_NAME, "--category-name" },
+		{ HOMEPAGE,      "--homepage" },
+		{ IUSE,          "--use" },
+		{ USE_ENABLED,   "--installed-with-use" },
+		{ USE_DISABLED,  "--installed-without-use" },
+		{ SRC_URI,       "--src-uri" },
+		{ EAPI,          "--eapi" },
+		{ INST_EAPI,     "--installed-eapi" },
+		{ SLOT,          "--slot" },
+		{ FULLSLOT,      "--fullslot" },
+		{ INST_SLOT,     "--installed-slot" },
+		{ INST_FULLSLOT, "--installed-fullslot" },
+		{ SET,           "--set" },
+		{ DEPENDA,       "--available-depend" },
+		{ RDEPENDA,      "--available-rdepend" },
+		{ PDEPENDA,      "--available-pdepend" },
+		{ BDEPENDA,      "--available-bdepend" },
+		{ DEPENDI,       "--installed-depend" },
+		{ RDEPENDI,      "--installed-rdepend" },
+		{ PDEPENDI,      "--installed-pdepend" },
+		{ BDEPENDI,      "--installed-bdepend" }
+	};
+	static CONSTEXPR const struct {
+		ExtendedVersion::Restrict restrict;
+		const char *name;
+	} restrict_names[] = {
+		{ ExtendedVersion::RESTRICT_BINCHECKS,      "--restrict-binchecks" },
+		{ ExtendedVersion::RESTRICT_STRIP,          "--restrict-strip" },
+		{ ExtendedVersion::RESTRICT_TEST,           "--restrict-test" },
+		{ ExtendedVersion::RESTRICT_USERPRIV,       "--restrict-userpriv" },
+		{ ExtendedVersion::RESTRICT_INSTALLSOURCES, "--restrict-installsources" },
+		{ ExtendedVersion::RESTRICT_FETCH,          "--restrict-fetch" },
+		{ ExtendedVersion::RESTRICT_MIRROR,         "--restrict-mirror" },
+		{ ExtendedVersion::RESTRICT_PRIMARYURI,     "--restrict-primaryuri" },
+		{ ExtendedVersion::RESTRICT_BINDIST,        "--restrict-bindist" },
+		{ ExtendedVersion::RESTRICT_PARALLEL,       "--restrict-parallel" }
+	};
+	static CONSTEXPR const struct {
+		ExtendedVersion::Properties properties;
+		const char *name;
+	} properties_names[] = {
+		{ ExtendedVersion::PROPERTIES_INTERACTIVE, "--properties-interactive" },
+		{ ExtendedVersion::PROPERTIES_LIVE,        "--properties-live" },
+		{ ExtendedVersion::PROPERTIES_VIRTUAL,     "--properties-virtual" },
+		{ ExtendedVersion::PROPERTIES_SET,         "--properties-set" }
+	};
+	string ret;
+	if((algorithm != NULLPTR) && !(algorithm->getString().empty())) {
+		// Each string is "fields algorithm string"; absorbed strings are or'ed
+		string prefix;
+		for(unsigned int i(0); i < sizeof(field_names) / sizeof(field_names[0]); ++i) {
+			if((field & field_names[i].field) != NONE) {
+				append_word(&prefix, field_names[i].name);
+			}
+		}
+		append_word(&prefix, algorithm->option());
+		WordVec strings;
+		algorithm->getStrings(&strings);
+		const bool several(strings.size() > 1);
+		if(several) {
+			ret.assign("--open");
+		}
+		for(WordVec::const_iterator it(strings.begin());
+			likely(it != strings.end()); ++it) {
+			if(it != strings.begin()) {
+				ret.append(" --or");
+			}
+			append_word(&ret, prefix.c_str());
+			append_quoted(&ret, *it);
+		}
+		if(several) {
+			ret.append(" --close");
+		}
+	}
+	if(installed) {
+		append_word(&ret, multi_installed ? "-i" : "-I");
+	}
+	if(slotted) {
+		append_word(&ret, multi_slot ? "-2" : "-1");
+	}
+	if(overlay) {
+		append_word(&ret, "-O");
+	}
+	if(dup_packages) {
+		append_word(&ret, "-d");
+	}
+	if(dup_versions) {
+		append_word(&ret, "-D");
+	}
+	if(have_virtual) {
+		append_word(&ret, "--virtual");
+	}
+	if(have_nonvirtual) {
+		append_word(&ret, "--nonvirtual");
+	}
+	append_overlays(&ret, "--in-overlay", overlay_list);
+	append_overlays(&ret, "--only-in-overlay", overlay_only_list);
+	append_overlays(&ret, "--installed-in-overlay", in_overlay_inst_list);
+	if(from_foreign_overlay_inst_list != NULLPTR) {
+		for(WordVec::const_iterator it(from_foreign_overlay_inst_list->begin());
+			likely(it != from_foreign_overlay_inst_list->end()); ++it) {
+			if(it->empty()) {
+				append_word(&ret, "--installed-overlay");
+			} else {
+				append_word(&ret, "--installed-from-overlay");
+				append_quoted(&ret, *it);
+			}
+		}
+	}
+	if(binarynum == 1) {
+		append_word(&ret, "--binary");
+	} else if(binarynum != 0) {
+		append_word(&ret, "--multi-binary");
+		ret.append(eix::format(" %s") % binarynum);
+	}
+	for(unsigned int i(0); i < sizeof(restrict_names) / sizeof(restrict_names[0]); ++i) {
+		if((restrictions & restrict_names[i].restrict) != ExtendedVersion::RESTRICT_NONE) {
+			append_word(&ret, restrict_names[i].name);
+		}
+	}
+	for(unsigned int i(0); i < sizeof(properties_names) / sizeof(properties_names[0]); ++i) {
+		if((properties & properties_names[i].properties) != ExtendedVersion::PROPERTIES_NONE) {
+			append_word(&ret, properties_names[i].name);
+		}
+	}
+	if(!revdep_name.empty()) {
+		append_word(&ret, "--rdeps");
+		append_quoted(&ret, revdep_name);
+	}
+	if(obsolete) {
+		append_word(&ret, "-T");
+	}
+	if(upgrade) {
+		append_word(&ret, (upgrade_local_mode == LOCALMODE_LOCAL) ? "--upgrade+" :
+			((upgrade_local_mode == LOCALMODE_NONLOCAL) ? "--upgrade-" : "--upgrade"));
+	}
+	append_stability(&ret, test_stability_default, "");
+	append_stability(&ret, test_stability_local, "+");
+	append_stability(&ret, test_stability_nonlocal, "-");
+	if((test_instability & STABLE_FULL) != STABLE_NONE) {
+		append_word(&ret, "--installed-unstable");
+	}
+	if((test_instability & STABLE_TESTING) != STABLE_NONE) {
+		append_word(&ret, "--installed-testing");
+	}
+	if((test_instability & STABLE_NONMASKED) != STABLE_NONE) {
+		append_word(&ret, "--installed-masked");
+	}
+	if(world) {
+		append_word(&ret, world_only_selected ?
+			(world_only_file ? "--selected-file" : "--selected") :
+			(world_only_file ? "--world-file" : "--world"));
+	}
+	if(worldset) {
+		append_word(&ret, worldset_only_selected ? "--selected-set" : "--world-set");
+	}
+	return ret;
+}
+
+/**
+@return category/name of pkg, composed in buffer
+**/
+ATTRIBUTE_NONNULL_ static const char *category_name(string *buffer, const Package *pkg);
+static const char *category_name(string *buffer, const Package *pkg) {
+	buffer->assign(pkg->category);
+	buffer->append(1, '/');
+	buffer->append(pkg->name);
+	return buffer->c_str();
 }
 
 /**
@@ -199,7 +564,7 @@ bool PackageTest::stringMatch(Package *pkg) const {
 	|| (((field & DESCRIPTION) != NONE)  && (*algorithm)(pkg->desc.c_str(), pkg))
 	|| (((field & LICENSE) != NONE) && (*algorithm)(pkg->licenses.c_str(), pkg))
 	|| (((field & CATEGORY) != NONE) && (*algorithm)(pkg->category.c_str(), pkg, true))
-	|| (((field & CATEGORY_NAME) != NONE) && (*algorithm)((pkg->category + "/" + pkg->name).c_str(), pkg, true))
+	|| (((field & CATEGORY_NAME) != NONE) && (*algorithm)(category_name(&match_buffer, pkg), pkg, true))
 	|| (((field & HOMEPAGE) != NONE) && (*algorithm)(pkg->homepage.c_str(), pkg))) {
 		return true;
 	}
@@ -223,7 +588,7 @@ bool PackageTest::stringMatch(Package *pkg) const {
 	if((field & SLOT) != NONE) {
 		for(Package::iterator it(pkg->begin());
 			likely(it != pkg->end()); ++it) {
-			if((*algorithm)(it->get_longslot().c_str(), pkg))
+			if((*algorithm)(it->get_longslot_c_str(), pkg))
 				return true;
 		}
 	}
@@ -231,7 +596,7 @@ bool PackageTest::stringMatch(Package *pkg) const {
 	if((field & FULLSLOT) != NONE) {
 		for(Package::iterator it(pkg->begin());
 			likely(it != pkg->end()); ++it) {
-			if((*algorithm)(it->get_longfullslot().c_str(), pkg))
+			if((*algorithm)(it->get_longfullslot(&match_buffer), pkg))
 				return true;
 		}
 	}
@@ -253,10 +618,10 @@ bool PackageTest::stringMatch(Package *pkg) const {
 		for(Package::iterator it(pkg->begin());
 			likely(it != pkg->end()); ++it) {
 			const Depend &dep(it->depend);
-			if((depend && (*algorithm)(dep.get_depend().c_str(), pkg))
-			|| (rdepend && (*algorithm)(dep.get_rdepend().c_str(), pkg))
-			|| (pdepend && (*algorithm)(dep.get_pdepend().c_str(), pkg))
-			|| (bdepend && (*algorithm)(dep.get_bdepend().c_str(), pkg))) {
+			if((depend && (*algorithm)(dep.get_depend(&match_buffer), pkg))
+			|| (rdepend && (*algorithm)(dep.get_rdepend(&match_buffer), pkg))
+			|| (pdepend && (*algorithm)(dep.get_pdepend(&match_buffer), pkg))
+			|| (bdepend && (*algorithm)(dep.get_bdepend(&match_buffer), pkg))) {
 				return true;
 			}
 		}
@@ -267,8 +632,12 @@ bool PackageTest::stringMatch(Package *pkg) const {
 		portagesettings->get_setnames(&setnames, pkg);
 		for(WordSet::const_iterator it(setnames.begin());
 			likely(it != setnames.end()); ++it) {
-			if((*algorithm)(it->c_str(), NULLPTR)
-			|| (*algorithm)((string("@") + *it).c_str(), NULLPTR)) {
+			if((*algorithm)(it->c_str(), NULLPTR)) {
+				return true;
+			}
+			match_buffer.assign(1, '@');
+			match_buffer.append(*it);
+			if((*algorithm)(match_buffer.c_str(), NULLPTR)) {
 				return true;
 			}
 		}
@@ -350,19 +719,19 @@ bool PackageTest::stringMatch(Package *pkg) const {
 			vardbpkg->readDepend(*pkg, &(*it), *header);
 			const Depend& dep(it->depend);
 			if(depend) {
-				if((*algorithm)(dep.get_depend().c_str(), pkg))
+				if((*algorithm)(dep.get_depend(&match_buffer), pkg))
 				return true;
 			}
 			if(rdepend) {
-				if((*algorithm)(dep.get_rdepend().c_str(), pkg))
+				if((*algorithm)(dep.get_rdepend(&match_buffer), pkg))
 				return true;
 			}
 			if(pdepend) {
-				if((*algorithm)(dep.get_pdepend().c_str(), pkg))
+				if((*algorithm)(dep.get_pdepend(&match_buffer), pkg))
 				return true;
 			}
 			if(bdepend) {
-				if((*algorithm)(dep.get_bdepend().c_str(), pkg))
+				if((*algorithm)(dep.get_bdepend(&match_buffer), pkg))
 				return true;
 			}
 		}
@@ -517,9 +886,166 @@ inline static void get_p(Package **p, PackageReader *pkg) {
 	}
 }
 
+bool PackageTest::installedtest(const Package *p) const {
+	InstVec::size_type s(vardbpkg->numInstalled(*p));
+	if(s == 0) {
+		return false;
+	}
+	if(s == 1) {
+		if(multi_installed) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool PackageTest::iuse_candidate(PackageReader *pkg) const {
+	if(unlikely(!know_iuse_candidates)) {
+		know_iuse_candidates = true;
+		const DBHeader::IUseIndex *index(pkg->iuse_index());
+		if(index == NULLPTR) {
+			return true;
+		}
+		// Match each IUSE of the database only once
+		iuse_candidates = new vector<bool>;
+		for(DBHeader::IUseIndex::size_type i(0); likely(i < index->size()); ++i) {
+			if(!(*algorithm)(IUse(header->iuse_hash[i]).name().c_str(), NULLPTR)) {
+				continue;
+			}
+			const vector<eix::Treesize>& packages((*index)[i]);
+			for(vector<eix::Treesize>::const_iterator it(packages.begin());
+				likely(it != packages.end()); ++it) {
+				if(*it >= iuse_candidates->size()) {
+					iuse_candidates->resize(*it + 1, false);
+				}
+				(*iuse_candidates)[*it] = true;
+			}
+		}
+	}
+	if(iuse_candidates == NULLPTR) {
+		return true;
+	}
+	eix::Treesize ordinal(pkg->ordinal());
+	return ((ordinal < iuse_candidates->size()) && (*iuse_candidates)[ordinal]);
+}
+
+bool PackageTest::name_candidate(PackageReader *pkg) const {
+	if(unlikely(!know_name_candidates)) {
+		know_name_candidates = true;
+		const FuzzyAlgorithm *fuzzy(algorithm->as_fuzzy());
+		if((fuzzy == NULLPTR) && (algorithm->as_exact() == NULLPTR) &&
+			(algorithm->as_begin() == NULLPTR) &&
+			(algorithm->as_end() == NULLPTR)) {
+			return true;
+		}
+		const NameIndex *index(pkg->name_index());
+		if(index == NULLPTR) {
+			return true;
+		}
+		// Names are always matched with simplified strings
+		algorithm->simplify();
+		vector<NameIndex::Index> found;
+		if(fuzzy != NULLPTR) {
+			index->find_fuzzy(&found, fuzzy->getString().c_str(), fuzzy->max_distance());
+		} else if(algorithm->as_begin() != NULLPTR) {
+			index->find_prefix(&found, algorithm->getString());
+		} else if(algorithm->as_end() != NULLPTR) {
+			index->find_suffix(&found, algorithm->getString());
+		} else {
+			WordVec strings;
+			algorithm->getStrings(&strings);
+			for(WordVec::const_iterator it(strings.begin());
+				likely(it != strings.end()); ++it) {
+				index->find_exact(&found, *it);
+			}
+		}
+		name_candidates = new vector<bool>;
+		for(vector<NameIndex::Index>::const_iterator it(found.begin());
+			likely(it != found.end()); ++it) {
+			const NameIndex::Packages& packages(index->entries[*it].packages);
+			for(NameIndex::Packages::const_iterator p(packages.begin());
+				likely(p != packages.end()); ++p) {
+				if(*p >= name_candidates->size()) {
+					name_candidates->resize(*p + 1, false);
+				}
+				(*name_candidates)[*p] = true;
+			}
+		}
+	}
+	if(name_candidates == NULLPTR) {
+		return true;
+	}
+	eix::Treesize ordinal(pkg->ordinal());
+	return ((ordinal < name_candidates->size()) && (*name_candidates)[ordinal]);
+}
+
+bool PackageTest::revdep_test(PackageReader *pkg) const {
+	if(unlikely(!know_revdep_candidates)) {
+		know_revdep_candidates = true;
+		const DBHeader::RevdepIndex *index(pkg->revdep_index());
+		if(index != NULLPTR) {
+			revdep_candidates = new vector<bool>;
+			DBHeader::RevdepIndex::const_iterator found(index->find(revdep_name));
+			if(found != index->end()) {
+				const vector<eix::Treesize>& packages(found->second);
+				if(likely(!packages.empty())) {
+					revdep_candidates->resize(packages.back() + 1, false);
+				}
+				for(vector<eix::Treesize>::const_iterator it(packages.begin());
+					likely(it != packages.end()); ++it) {
+					(*revdep_candidates)[*it] = true;
+				}
+			}
+		}
+	}
+	if(revdep_candidates != NULLPTR) {
+		eix::Treesize ordinal(pkg->ordinal());
+		return ((ordinal < revdep_candidates->size()) && (*revdep_candidates)[ordinal]);
+	}
+	pkg->read(PackageReader::VERSIONS);
+	const Package *p(pkg->get());
+	WordSet packages;
+	for(Package::const_iterator v(p->begin()); likely(v != p->end()); ++v) {
+		v->depend.add_packages(&packages);
+	}
+	return (packages.count(revdep_name) != 0);
+}
+
 bool PackageTest::match(PackageReader *pkg) const {
 	Package *p(NULLPTR);
 
+	// A pure IUSE test is mostly decided by the IUSE index of the database
+	if(unlikely(field == IUSE) && !iuse_candidate(pkg)) {
+		return false;
+	}
+
+	// An exact, begin, end, or fuzzy name test is decided by the name
+	// index of the database; only the candidates are read, e.g. to store
+	// their distance for sorting
+	if((field == NAME) && !name_candidate(pkg)) {
+		return false;
+	}
+
+	// -1 -2 -O -d -D and nonlocal stability are prefiltered by the database
+	if(unlikely(require_dbflags != Package::DBFLAGS_NONE) &&
+		!pkg->dbflags(require_dbflags)) {
+		return false;
+	}
+
+	if(unlikely(!revdep_name.empty()) && !revdep_test(pkg)) {
+		return false;
+	}
+
+	// -i or -I needs only the name and is cheap, so do it before reading more
+	const bool installed_first(installed && (need > PackageReader::NAME));
+	if(unlikely(installed_first)) {
+		pkg->read(PackageReader::NAME);
+		get_p(&p, pkg);
+		if(!installedtest(p)) {
+			return false;
+		}
+	}
+
 	pkg->read(need);
 
 	/* Test the local options.
@@ -619,18 +1145,12 @@ bool PackageTest::match(PackageReader *pkg) const {
 		}
 	}
 
-	if(unlikely(installed)) {
+	if(unlikely(installed && !installed_first)) {
 		// -i or -I
 		get_p(&p, pkg);
-		InstVec::size_type s(vardbpkg->numInstalled(*p));
-		if(s == 0) {
+		if(!installedtest(p)) {
 			return false;
 		}
-		if(s == 1) {
-			if(multi_installed) {
-				return false;
-			}
-		}
 	}
 
 	if(unlikely(in_overlay_inst_list != NULLPTR)) {
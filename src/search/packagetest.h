@@ -133,6 +133,34 @@ class PackageTest {
 		**/
 		void finalize();
 
+		typedef unsigned int Cost;
+
+		/**
+		@return estimated relative cost of match(); valid after finalize()
+		**/
+		Cost cost() const {
+			return cost_estimate;
+		}
+
+		/**
+		@return false if calls of match() must neither be skipped nor
+		reordered with other tests
+		**/
+		ATTRIBUTE_PURE bool reorderable() const;
+
+		/**
+		Take over the search strings of other, i.e. afterwards this
+		matches if this or other matched before; valid after finalize()
+		@return false if this is not possible, e.g. if some of the tests
+		is more than a string test
+		**/
+		ATTRIBUTE_NONNULL_ bool absorb(const PackageTest *other);
+
+		/**
+		@return a short description of the test for --explain
+		**/
+		std::string explain() const;
+
 		/*
 		The constructor of the class *must* set the least restrictive choice.
 		Since --selected --world must act like --selected, the less restrictive
@@ -195,6 +223,13 @@ class PackageTest {
 			overlay = true;
 		}
 
+		/**
+		Match packages with a dependency on category/name
+		**/
+		void ReverseDeps(const std::string& name) {
+			revdep_name = name;
+		}
+
 		void Restrictions(ExtendedVersion::Restrict flags) {
 			restrictions |= flags;
 		}
@@ -329,6 +364,14 @@ class PackageTest {
 		**/
 		PackageReader::Attributes need;
 		/**
+		Flags which the package must have according to the database
+		**/
+		Package::DBFlags require_dbflags;
+		/**
+		Estimated cost of match(), see calculateCost()
+		**/
+		Cost cost_estimate;
+		/**
 		Our string matching algorithm
 		**/
 		BaseAlgorithm *algorithm;
@@ -359,6 +402,38 @@ class PackageTest {
 
 		MaskList<Mask> *marked_list;
 
+		/**
+		Cache for iuse_candidate(): The ordinal numbers of packages
+		which might match, or NULLPTR if the database has no IUSE index
+		**/
+		mutable std::vector<bool> *iuse_candidates;
+		mutable bool know_iuse_candidates;
+
+		/**
+		Cache for name_candidate(): The ordinal numbers of packages
+		which might match, or NULLPTR if the database has no name index
+		**/
+		mutable std::vector<bool> *name_candidates;
+		mutable bool know_name_candidates;
+
+		/**
+		--rdeps: category/name of the dependency or empty
+		**/
+		std::string revdep_name;
+
+		/**
+		Cache for revdep_test(): The ordinal numbers of the matching
+		packages, or NULLPTR if the database has no reverse dependency index
+		**/
+		mutable std::vector<bool> *revdep_candidates;
+		mutable bool know_revdep_candidates;
+
+		/**
+		Scratch space for stringMatch() so that composed strings
+		need not be allocated anew for every package
+		**/
+		mutable std::string match_buffer;
+
 		PortageSettings *portagesettings;
 		/**
 		Lookup stuff about user flags here
@@ -383,6 +458,11 @@ class PackageTest {
 
 		ATTRIBUTE_NONNULL_ bool stringMatch(Package *pkg) const;
 
+		/**
+		@return true if the test consists only of stringMatch()
+		**/
+		ATTRIBUTE_PURE bool only_string_test() const;
+
 		void setNeeds(const PackageReader::Attributes i) {
 			if(need < i) {
 				need = i;
@@ -394,6 +474,40 @@ class PackageTest {
 		**/
 		void calculateNeeds();
 
+		/**
+		Calculate require_dbflags
+		**/
+		void calculateDBFlags();
+
+		/**
+		Estimate the cost of match(); must be called after calculateNeeds()
+		**/
+		void calculateCost();
+
+		/**
+		For a pure IUSE test: Use the IUSE index of the database to
+		find out whether the package might match before reading it
+		**/
+		ATTRIBUTE_NONNULL_ bool iuse_candidate(PackageReader *pkg) const;
+
+		/**
+		For a pure exact, begin, end, or fuzzy name test: Use the name
+		index of the database to find out whether the package might match
+		before reading it
+		**/
+		ATTRIBUTE_NONNULL_ bool name_candidate(PackageReader *pkg) const;
+
+		/**
+		--rdeps: Use the reverse dependency index of the database if
+		there is one; otherwise read the dependencies of all versions
+		**/
+		ATTRIBUTE_NONNULL_ bool revdep_test(PackageReader *pkg) const;
+
+		/**
+		-i or -I
+		**/
+		ATTRIBUTE_NONNULL_ bool installedtest(const Package *p) const;
+
 		bool have_redundant(const Package& p, Keywords::Redundant r, const RedAtom& t) const;
 		bool have_redundant(const Package& p, Keywords::Redundant r) const;
 		ATTRIBUTE_NONNULL_ bool instabilitytest(const Package *p, TestStability what) const;
@@ -10,6 +10,7 @@
 #include "various/cli.h"
 #include <config.h>  // IWYU pragma: keep
 
+#include <cstdlib>
 #include <iostream>
 #include <string>
 
@@ -17,6 +18,8 @@
 #include "eixTk/argsreader.h"
 #include "eixTk/attribute.h"
 #include "eixTk/dialect.h"
+#include "eixTk/formated.h"
+#include "eixTk/i18n.h"
 #include "eixTk/likely.h"
 #include "eixTk/null.h"
 #include "eixTk/stringtypes.h"
@@ -24,6 +27,7 @@
 #include "eixrc/eixrc.h"
 #include "output/formatstring.h"
 #include "portage/basicversion.h"
+#include "portage/depend.h"
 #include "portage/conf/portagesettings.h"
 #include "portage/mask.h"
 #include "portage/mask_list.h"
@@ -465,6 +469,19 @@ void parse_cli(MatchTree *matchtree, EixRc *eixrc, VarDbPkg *varpkg_db, PortageS
 			case O_INSTALLED_DEPS: USE_TEST;
 				*test |= PackageTest::DEPSI;
 				break;
+			case O_RDEPS: USE_TEST;
+				if(unlikely(!(Depend::use_depend && header->use_depend))) {
+					eix::say_error(_("--rdeps needs DEP=true (also for eix-update)"));
+					std::exit(EXIT_FAILURE);
+				}
+				if(likely(optional_increase(&arg, ar))) {
+					string name;
+					if(!Depend::atom_package(&name, arg->m_argument)) {
+						name = arg->m_argument;
+					}
+					test->ReverseDeps(name);
+				}
+				break;
 			case O_SEARCH_SET: USE_TEST;
 				*test |= PackageTest::SET;
 				break;
@@ -580,13 +597,14 @@ void parse_cli(MatchTree *matchtree, EixRc *eixrc, VarDbPkg *varpkg_db, PortageS
 			if(m.parseMask(word->c_str(), &errtext, -1) != BasicVersion::parsedError) {
 				if(unlikely(*marked_list == NULLPTR)) {
 					*marked_list = new MaskList<Mask>;
+					// All words are looked up in this one marked_list,
+					// so a single test suffices
+					NEW_TEST;
+					*test = PackageTest::CATEGORY_NAME;
+					test->SetMarkedList(*marked_list);
+					matchtree->set_pipetest(test);
 				}
 				(*marked_list)->add(m);
-
-				NEW_TEST;
-				*test = PackageTest::CATEGORY_NAME;
-				test->SetMarkedList(*marked_list);
-				matchtree->set_pipetest(test);
 			}
 		}
 	}
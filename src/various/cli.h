@@ -40,7 +40,11 @@ enum cli_options {
 	O_FMT = 256,
 	O_XML,
 	O_PROTO,
+	O_PROTO_STREAM,
+	O_JSONL,
 	O_PRINT_VAR,
+	O_COMPLETE,
+	O_LIMIT,
 	O_PIPE_MASK,
 	O_ANSI,
 	O_P256,
@@ -107,6 +111,7 @@ enum cli_options {
 	O_NONVIRTUAL,
 	O_VIRTUAL,
 	O_DEBUG,
+	O_EXPLAIN,
 	O_SEARCH_SRC_URI,
 	O_SEARCH_EAPI,
 	O_SEARCH_INST_EAPI,
@@ -131,6 +136,7 @@ enum cli_options {
 	O_INSTALLED_PDEPEND,
 	O_INSTALLED_BDEPEND,
 	O_INSTALLED_DEPS,
+	O_RDEPS,
 	O_RESTRICT_FETCH,
 	O_RESTRICT_MIRROR,
 	O_RESTRICT_PRIMARYURI,